@@ -25,21 +25,6 @@ typedef struct Sprite
     Source source;
 } Sprite;
 
-class Car
-{
-public:
-    int index;
-    float offset; // Offset dell'auto sulla strada (-1 a 1)
-    float z;
-    Sprite sprite; // Sprite dell'auto
-    float speed;   // Velocità dell'auto
-    float percent;
-    bool operator==(const Car &car) const
-    {
-        return car.index == index;
-    }
-};
-
 struct Colors
 {
     Color road;   // Colore della strada
@@ -76,44 +61,16 @@ const Colors FINISH = {
     {0, 0, 0, 0xFF}  // Rumble (Black)
 };
 
-// Punto 3D (mondo, camera, schermo)
-struct Point3D
+// Indici dei colori dei segmenti
+struct PALETTE
 {
-    struct
-    {
-        float x = 0.0f;
-        float y = 0.0f;
-        float z = 0.0f;
-    } world;
-
-    struct
-    {
-        float x = 0.0f;
-        float y = 0.0f;
-        float z = 0.0f;
-    } camera;
-
-    struct
-    {
-        float x = 0.0f;
-        float y = 0.0f;
-        float w = 0.0f;
-        float scale = 0.0f;
-    } screen;
+    static constexpr unsigned char DARK = 0;
+    static constexpr unsigned char LIGHT = 1;
+    static constexpr unsigned char START = 2;
+    static constexpr unsigned char FINISH = 3;
 };
 
-struct Segment
-{
-    size_t index;                // Indice del segmento
-    std::vector<Car> cars;       // Auto nel segmento
-    Point3D p1, p2;              // Punti del segmento
-    float curve;                 // Curva del segmento
-    std::vector<Sprite> sprites; // Indici degli sprite (da implementare)
-    Colors color;                // Colore del segmento
-    bool looped;
-    float fog;
-    float clip;
-};
+const Colors SEGMENT_COLORS[] = {DARK, LIGHT, START, FINISH};
 
 struct ROAD
 {
@@ -148,6 +105,10 @@ namespace BACKGROUND
     const Sprite HILLS = {5, 5, 1280, 480};
     const Sprite SKY = {5, 495, 1280, 480};
     const Sprite TREES = {5, 985, 1280, 480};
+
+    // Strati dello sfondo nell'ordine di disegno (indici per Drawing::DrawBackground)
+    enum Layer { LAYER_SKY = 0, LAYER_HILLS, LAYER_TREES, LAYER_COUNT };
+    const Sprite LAYERS[LAYER_COUNT] = {SKY, HILLS, TREES};
 }
 
 // Namespace per sprite
@@ -4,114 +4,105 @@
 #include "drawing.hpp"
 
 #include <cstdlib>
+#include <algorithm>
 
-// Funzione per disegnare un poligono
+// Funzione per accodare un poligono alla lista della strada
 void Drawing::DrawPolygon(Color color, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4) {
-    Vector2 vertices[] = {{x1, y1},
-                          {x2, y2},
-                          {x3, y3},
-                          {x4, y4}};
-    DrawTriangle(vertices[0], vertices[1], vertices[2], color);
-    DrawTriangle(vertices[2], vertices[3], vertices[0], color);
+    roadList.addQuad(color, x1, y1, x2, y2, x3, y3, x4, y4);
 }
 
-// Funzione per disegnare un segmento di strada
+// Funzione per accodare un segmento di strada alla lista della strada
 void
 Drawing::DrawSegment(int screenWidth, int _lanes, float x1, float y1, float w1, float x2, float y2, float w2, float fog,
                      const Colors &color) {
-    float r1 = w1 / std::max(6.0f, 2.0f * _lanes);
-    float r2 = w2 / std::max(6.0f, 2.0f * _lanes);
-    float l1 = w1 / std::max(32.0f, 8.0f * _lanes);
-    float l2 = w2 / std::max(32.0f, 8.0f * _lanes);
-
-    // Disegna l'erba
-    DrawRectangle(0, static_cast<int>(y2), static_cast<int>(screenWidth), static_cast<int>(y1 - y2), color.grass);
-
-    // Disegna il bordo (rumble strips)
-    DrawPolygon(color.rumble, x1 - w1 - r1, y1, x1 - w1, y1, x2 - w2, y2, x2 - w2 - r2, y2);
-    DrawPolygon(color.rumble, x1 + w1 + r1, y1, x1 + w1, y1, x2 + w2, y2, x2 + w2 + r2, y2);
-
-    // Disegna la strada
-    DrawPolygon(color.road, x1 - w1, y1, x1 + w1, y1, x2 + w2, y2, x2 - w2, y2);
-
-    // Disegna le linee della corsia
-    if (color.lane.a > 0) { // Se è specificato un colore per le linee
-        float laneWidth1 = w1 * 2 / _lanes;
-        float laneWidth2 = w2 * 2 / _lanes;
-        float laneX1 = x1 - w1 + laneWidth1;
-        float laneX2 = x2 - w2 + laneWidth2;
-
-        for (int lane = 1; lane < _lanes; lane++) {
-            DrawPolygon(color.lane, laneX1 - l1 / 2, y1, laneX1 + l1 / 2, y1, laneX2 + l2 / 2, y2, laneX2 - l2 / 2, y2);
-            laneX1 += laneWidth1;
-            laneX2 += laneWidth2;
-        }
+    roadList.addSegment(screenWidth, _lanes, x1, y1, w1, x2, y2, w2, fog, color);
+}
+
+// Funzione per accodare tutte le righe della tabella che contengono la strada
+void Drawing::DrawRoadLines(int screenWidth, int _lanes, const RoadLines &lines) {
+    for (int row = 0; row < lines.size(); row++) {
+        if (lines.palette[row] != RoadLines::EMPTY)
+            roadList.addLine(row, screenWidth, _lanes, lines.centerX[row], lines.halfWidth[row],
+                             lines.fog[row], SEGMENT_COLORS[lines.palette[row]]);
     }
 }
 
-// Funzione per disegnare un elemento di sfondo
-void Drawing::DrawBackground(const Texture2D &_background, int _width, int _height, const Sprite &layer,
-                             float rotation = 0.0f, float offset = 0.0f) {
-    int imageW = layer.w / 2;
-    int imageH = layer.h;
-
-    int sourceX = layer.x + static_cast<int>(layer.w * rotation) % layer.w;
-    int sourceY = layer.y;
-    int sourceW = std::min(imageW, layer.w - sourceX);
-    int sourceH = imageH;
-
-    int destX = 0;
-    int destY = static_cast<int>(offset);
-    int destW = static_cast<int>(_width * (static_cast<float>(sourceW) / imageW));
-    int destH = _height;
-
-    Rectangle sourceRec = {static_cast<float>(sourceX), static_cast<float>(sourceY), static_cast<float>(sourceW),
-                           static_cast<float>(sourceH)};
-    Rectangle destRec = {static_cast<float>(destX), static_cast<float>(destY), static_cast<float>(destW),
-                         static_cast<float>(destH)};
-
-    DrawTexturePro(_background, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
-    if (sourceW < imageW) {
-        sourceRec = {static_cast<float>(layer.x), static_cast<float>(sourceY), static_cast<float>(imageW - sourceW),
-                     static_cast<float>(sourceH)};
-        destRec = {static_cast<float>(destW - 1), static_cast<float>(destY), static_cast<float>(_width - destW),
-                   static_cast<float>(destH)};
-        DrawTexturePro(_background, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
+// Funzione per impaginare un testo nell'atlante del font
+void Drawing::LayoutText(const char *text, float x, float y, GlyphRun &run) const {
+    run.count = 0;
+    if (font.glyphs == nullptr)
+        return;
+
+    float padding = static_cast<float>(font.glyphPadding);
+    float offsetX = 0.0f;
+
+    for (const char *c = text; *c != '\0' && run.count < GlyphRun::MAX_GLYPHS; c++) {
+        int index = GetGlyphIndex(font, static_cast<unsigned char>(*c));
+        const Rectangle &rec = font.recs[index];
+        const GlyphInfo &glyph = font.glyphs[index];
+
+        if (*c != ' ' && *c != '\t') {
+            SpriteInstance &instance = run.glyphs[run.count++];
+            instance.source = {rec.x - padding, rec.y - padding, rec.width + 2 * padding, rec.height + 2 * padding};
+            instance.dest = {x + offsetX + glyph.offsetX - padding, y + glyph.offsetY - padding,
+                             rec.width + 2 * padding, rec.height + 2 * padding};
+        }
+
+        offsetX += (glyph.advanceX == 0 ? rec.width : static_cast<float>(glyph.advanceX)) + 1.0f;
     }
 }
 
-// Funzione per disegnare uno sprite
-void Drawing::DrawSprite(const Texture2D &spriteSheet, int screenWidth, int screenHeight, float _resolution,
-                         float _roadWidth,
-                         const Sprite &sprite, float scale, float destX, float destY, float offsetX = 0.0f,
-                         float offsetY = 0.0f, float clipY = 0.0f) {
+// Calcola i rettangoli sorgente e destinazione di uno strato dello sfondo
+void Drawing::BackgroundRect(int _width, int _height, int layer, float rotation, float offset, Rectangle &source,
+                             Rectangle &dest) {
+    const Sprite &sprite = BACKGROUND::LAYERS[layer];
+    int sourceX = static_cast<int>(sprite.w * rotation) % sprite.w;
+
+    source = {static_cast<float>(sourceX), 0.0f, static_cast<float>(sprite.w / 2), static_cast<float>(sprite.h)};
+    dest = {0.0f, static_cast<float>(static_cast<int>(offset)), static_cast<float>(_width), static_cast<float>(_height)};
+}
+
+// Funzione per accodare uno sprite alla lista degli sprite
+bool Drawing::SpriteRect(int screenWidth, int screenHeight, float _roadWidth, const Sprite &sprite, float scale,
+                         float destX, float destY, float offsetX, float offsetY, float clipY,
+                         Rectangle &source, Rectangle &dest) {
     float destW = (sprite.w * scale * screenWidth / 2) * SPRITE_SCALE * _roadWidth;
     float destH = (sprite.h * scale * screenWidth / 2) * SPRITE_SCALE * _roadWidth;
 
+    if (destW <= 0.0f || destH <= 0.0f)
+        return false;
+
     destX += destW * offsetX;
     destY += destH * offsetY;
 
+    // Fuori dallo schermo a destra, a sinistra o sopra/sotto
+    if (destX >= screenWidth || destX + destW <= 0.0f || destY >= screenHeight || destY + destH <= 0.0f)
+        return false;
+
     float clipH = clipY > 0.0f ? std::max(0.0f, destY + destH - clipY) : 0.0f;
-    if (clipH < destH) {
-        Rectangle sourceRec = {static_cast<float>(sprite.x), static_cast<float>(sprite.y), static_cast<float>(sprite.w),
-                               static_cast<float>(sprite.h) - (sprite.h * clipH / destH)};
-        Rectangle destRec = {destX, destY, destW, destH - clipH};
-        DrawTexturePro(spriteSheet, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
-    }
+    if (clipH >= destH)
+        return false;
+
+    source = {static_cast<float>(sprite.x), static_cast<float>(sprite.y), static_cast<float>(sprite.w),
+              static_cast<float>(sprite.h) - (sprite.h * clipH / destH)};
+    dest = {destX, destY, destW, destH - clipH};
+    return true;
 }
 
-// Funzione per disegnare la nebbia
-void Drawing::DrawFog(int x, int y, int _width, int _height, float fogIntensity) {
-    if (fogIntensity < 1.0f) {
-        Color fogColor = {FOG.road.r, FOG.road.g, FOG.road.b, static_cast<unsigned char>(255 * (1.0f - fogIntensity))};
-        DrawRectangle(x, y, _width, _height, fogColor);
-    }
+void Drawing::DrawSprite(int screenWidth, int screenHeight, float _resolution,
+                         float _roadWidth,
+                         const Sprite &sprite, float scale, float destX, float destY, float offsetX = 0.0f,
+                         float offsetY = 0.0f, float clipY = 0.0f) {
+    Rectangle sourceRec, destRec;
+    if (SpriteRect(screenWidth, screenHeight, _roadWidth, sprite, scale, destX, destY, offsetX, offsetY, clipY,
+                   sourceRec, destRec))
+        spriteList.add(sourceRec, destRec);
 }
 
 void
-Drawing::DrawPlayer(Texture2D texture, int _width, int _height, float _resolution, float _roadWidth, float speedPercent,
-                    float scale, float destX, float destY, float steer, float updown, bool paused) {
-    float bounce = (1.5f * Util::randomFloat() * speedPercent * _resolution) * ((rand() % 2) == 0 ? -1 : 1);
+Drawing::DrawPlayer(int _width, int _height, float _resolution, float _roadWidth, float speedPercent,
+                    float scale, float destX, float destY, float steer, float updown, bool paused, Random &random) {
+    float bounce = (1.5f * random.nextFloat() * speedPercent * _resolution) * ((random.next() & 1) == 0 ? -1 : 1);
     if (paused)
         bounce = 0.0f;
 
@@ -124,6 +115,6 @@ Drawing::DrawPlayer(Texture2D texture, int _width, int _height, float _resolutio
     else
         sprite = (updown > 0) ? SPRITES::PLAYER_UPHILL_STRAIGHT : SPRITES::PLAYER_STRAIGHT;
 
-    DrawSprite(texture, _width, _height, _resolution, _roadWidth, sprite, scale, destX, destY + bounce, -0.5f, -1.0f);
+    DrawSprite(_width, _height, _resolution, _roadWidth, sprite, scale, destX, destY + bounce, -0.5f, -1.0f);
 }
 
@@ -3,21 +3,90 @@
 
 #include "raylib.h"
 #include "util.hpp"
+#include "drawlist.hpp"
+#include "random.hpp"
+#include "roadlines.hpp"
 
+// Interfaccia dei backend di disegno.
+// Le funzioni comuni costruiscono le liste di disegno della strada e degli sprite;
+// ogni backend implementa come queste liste (e il resto del frame) vengono disegnate.
 class Drawing {
     public:
-        // Funzione per disegnare un poligono
+        virtual ~Drawing() = default;
+
+        // Funzione per caricare le risorse (sfondo, spritesheet e font)
+        virtual void LoadResources() = 0;
+        // Funzione per scaricare le risorse
+        virtual void UnloadResources() = 0;
+        // Funzioni di inizio e fine del frame
+        virtual void BeginFrame(int _width, int _height) = 0;
+        virtual void EndFrame() = 0;
+        // Chiude la scena, disegnata alla risoluzione di BeginFrame, e la scala alla finestra;
+        // quello che segue (HUD) viene disegnato alla risoluzione della finestra
+        virtual void BeginOverlay(int _width, int _height) = 0;
+
+        // Funzione per accodare un poligono alla lista della strada
         void DrawPolygon(Color color, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4);
-        // Funzione per disegnare un segmento di strada
+        // Funzione per accodare un segmento di strada alla lista della strada
         void DrawSegment(int screenWidth, int lanes, float x1, float y1, float w1, float x2, float y2, float w2, float fog, const Colors& color);
+        // Funzione per accodare la strada già risolta per righe (una riga = intervalli senza sovrapposizioni)
+        void DrawRoadLines(int screenWidth, int lanes, const RoadLines &lines);
+        // Funzione per disegnare tutti i quadrilateri accodati
+        virtual void FlushRoad() = 0;
         // Funzione per disegnare un elemento di sfondo
-        void DrawBackground(const Texture2D& background, int _width, int _height, const Sprite& layer, float rotation, float offset);
-        // Funzione per disegnare uno sprite
-        void DrawSprite(const Texture2D& spriteSheet, int screenWidth, int screenHeight, float resolution, float roadWidth,
+        // (layer è un indice in BACKGROUND::LAYERS, ogni strato si ripete orizzontalmente)
+        virtual void DrawBackground(int _width, int _height, int layer, float rotation, float offset) = 0;
+        // Calcola i rettangoli di uno sprite tagliato alla riga clipY (0 = nessun taglio); ritorna false
+        // se lo sprite è interamente fuori dallo schermo o nascosto sotto la riga di taglio
+        static bool SpriteRect(int screenWidth, int screenHeight, float roadWidth, const Sprite &sprite, float scale,
+                               float destX, float destY, float offsetX, float offsetY, float clipY,
+                               Rectangle &source, Rectangle &dest);
+        // Funzione per accodare uno sprite alla lista degli sprite
+        void DrawSprite(int screenWidth, int screenHeight, float resolution, float roadWidth,
                         const Sprite& sprite, float scale, float destX, float destY, float offsetX, float offsetY, float clipY);
-        // Funzione per disegnare la nebbia
-        void DrawFog(int x, int y, int _width, int _height, float fogIntensity);
-        void DrawPlayer(Texture2D texture, int _width, int _height, float resolution, float roadWidth, float speedPercent, float scale, float destX, float destY, float steer, float updown, bool paused);
+        // Funzione per accodare uno sprite di cui sono già noti i rettangoli (vedi SpriteRect)
+        void DrawSprite(const Rectangle &source, const Rectangle &dest) { spriteList.add(source, dest); }
+        // Funzione per disegnare tutti gli sprite accodati
+        virtual void FlushSprites() = 0;
+        void DrawPlayer(int _width, int _height, float resolution, float roadWidth, float speedPercent, float scale, float destX, float destY, float steer, float updown, bool paused, Random &random);
+
+        // Funzioni per l'HUD
+        virtual void DrawRectangle(int x, int y, int _width, int _height, Color color) = 0;
+        virtual void DrawRectangleLines(int x, int y, int _width, int _height, Color color) = 0;
+        virtual void DrawText(const char *text, float x, float y, Color color) = 0;
+        virtual void DrawFPS(int x, int y) = 0;
+
+        // Impagina il testo (al massimo GlyphRun::MAX_GLYPHS caratteri) come DrawTextEx con spaziatura 1
+        void LayoutText(const char *text, float x, float y, GlyphRun &run) const;
+        // Disegna un testo già impaginato
+        virtual void DrawGlyphs(const GlyphRun &run, Color color) = 0;
+
+        // Statistiche dell'ultimo FlushRoad
+        int GetRoadQuads() const { return roadQuads; }
+        int GetRoadDrawCalls() const { return roadDrawCalls; }
+        // Statistiche dell'ultimo FlushSprites
+        int GetSprites() const { return spriteCount; }
+        int GetSpriteDrawCalls() const { return spriteDrawCalls; }
+        // Tempo CPU speso dal backend dentro l'ultimo EndFrame (secondi, solo lavoro e non attesa del vsync)
+        double GetBackendTime() const { return backendTime; }
+
+    protected:
+        // Calcola il rettangolo sorgente (nelle coordinate dello strato; può uscire a destra, dove lo
+        // strato si ripete) e quello di destinazione di uno strato dello sfondo
+        static void BackgroundRect(int _width, int _height, int layer, float rotation, float offset,
+                                   Rectangle &source, Rectangle &dest);
+
+        RoadDrawList roadList;
+        int roadQuads = 0;
+        int roadDrawCalls = 0;
+
+        SpriteDrawList spriteList;
+        int spriteCount = 0;
+        int spriteDrawCalls = 0;
+
+        double backendTime = 0.0;
+
+        Font font = {};             // Font dell'HUD
 };
 
-#endif
\ No newline at end of file
+#endif
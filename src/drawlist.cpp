@@ -0,0 +1,87 @@
+#include "drawlist.hpp"
+
+#include <algorithm>
+
+void RoadDrawList::addSegment(int screenWidth, int lanes, float x1, float y1, float w1, float x2, float y2, float w2,
+                              float fog, const Colors &segmentColor) {
+    const Colors color = FogTable::apply(segmentColor, fog);
+    float r1 = w1 / std::max(6.0f, 2.0f * lanes);
+    float r2 = w2 / std::max(6.0f, 2.0f * lanes);
+    float l1 = w1 / std::max(32.0f, 8.0f * lanes);
+    float l2 = w2 / std::max(32.0f, 8.0f * lanes);
+
+    // Erba (rettangolo a tutta larghezza)
+    float top = static_cast<float>(static_cast<int>(y2));
+    float bottom = top + static_cast<float>(static_cast<int>(y1 - y2));
+    addQuad(color.grass, 0.0f, bottom, static_cast<float>(screenWidth), bottom, static_cast<float>(screenWidth), top, 0.0f, top);
+
+    // Bordo (rumble strips)
+    addQuad(color.rumble, x1 - w1 - r1, y1, x1 - w1, y1, x2 - w2, y2, x2 - w2 - r2, y2);
+    addQuad(color.rumble, x1 + w1 + r1, y1, x1 + w1, y1, x2 + w2, y2, x2 + w2 + r2, y2);
+
+    // Strada
+    addQuad(color.road, x1 - w1, y1, x1 + w1, y1, x2 + w2, y2, x2 - w2, y2);
+
+    // Linee della corsia
+    if (color.lane.a > 0) { // Se è specificato un colore per le linee
+        float laneWidth1 = w1 * 2 / lanes;
+        float laneWidth2 = w2 * 2 / lanes;
+        float laneX1 = x1 - w1 + laneWidth1;
+        float laneX2 = x2 - w2 + laneWidth2;
+
+        for (int lane = 1; lane < lanes; lane++) {
+            addQuad(color.lane, laneX1 - l1 / 2, y1, laneX1 + l1 / 2, y1, laneX2 + l2 / 2, y2, laneX2 - l2 / 2, y2);
+            laneX1 += laneWidth1;
+            laneX2 += laneWidth2;
+        }
+    }
+}
+
+void RoadDrawList::addLine(int y, int screenWidth, int lanes, float x, float w, float fog, const Colors &lineColor) {
+    const Colors color = FogTable::apply(lineColor, fog);
+    float r = w / std::max(6.0f, 2.0f * lanes);
+    float l = w / std::max(32.0f, 8.0f * lanes);
+    float top = static_cast<float>(y);
+    float bottom = top + 1.0f;
+    float right = static_cast<float>(screenWidth);
+
+    // Confini degli intervalli da sinistra a destra, ognuno con il colore che lo segue
+    const int maxLines = 16;
+    float edges[2 * maxLines + 6];
+    Color colors[2 * maxLines + 6];
+    int count = 0;
+
+    edges[count] = 0.0f;
+    colors[count++] = color.grass;
+    edges[count] = x - w - r;
+    colors[count++] = color.rumble;
+    edges[count] = x - w;
+    colors[count++] = color.road;
+
+    if (color.lane.a > 0) { // Se è specificato un colore per le linee
+        float laneWidth = w * 2 / lanes;
+        float laneX = x - w + laneWidth;
+
+        for (int lane = 1; lane < lanes && lane <= maxLines; lane++) {
+            edges[count] = laneX - l / 2;
+            colors[count++] = color.lane;
+            edges[count] = laneX + l / 2;
+            colors[count++] = color.road;
+            laneX += laneWidth;
+        }
+    }
+
+    edges[count] = x + w;
+    colors[count++] = color.rumble;
+    edges[count] = x + w + r;
+    colors[count++] = color.grass;
+
+    float left = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float end = i + 1 < count ? std::min(right, edges[i + 1]) : right;
+        if (end > left) {
+            addQuad(colors[i], left, bottom, end, bottom, end, top, left, top);
+            left = end;
+        }
+    }
+}
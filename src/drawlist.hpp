@@ -0,0 +1,77 @@
+#ifndef __DRAWLIST_HPP__
+#define __DRAWLIST_HPP__
+
+#include <vector>
+
+#include "raylib.h"
+#include "common.hpp"
+#include "fog.hpp"
+
+// Quadrilatero colorato (vertici in ordine)
+struct RoadQuad
+{
+    float x1, y1;
+    float x2, y2;
+    float x3, y3;
+    float x4, y4;
+    Color color;
+};
+
+// Lista dei quadrilateri della strada da disegnare nel frame
+class RoadDrawList
+{
+public:
+    void clear() { quads.clear(); }
+    size_t size() const { return quads.size(); }
+    const std::vector<RoadQuad> &getQuads() const { return quads; }
+
+    // Aggiunge un quadrilatero
+    void addQuad(Color color, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4)
+    {
+        quads.push_back({x1, y1, x2, y2, x3, y3, x4, y4, color});
+    }
+
+    // Aggiunge erba, bordi, strada e linee di corsia di un segmento, con i colori già miscelati con la nebbia
+    void addSegment(int screenWidth, int lanes, float x1, float y1, float w1, float x2, float y2, float w2, float fog, const Colors &color);
+
+    // Aggiunge una riga dello schermo divisa in intervalli che non si sovrappongono
+    // (erba, bordo, strada, linee di corsia, bordo, erba)
+    void addLine(int y, int screenWidth, int lanes, float x, float w, float fog, const Colors &color);
+
+private:
+    std::vector<RoadQuad> quads;
+};
+
+// Istanza di uno sprite: rettangolo sorgente nello spritesheet e destinazione sullo schermo
+struct SpriteInstance
+{
+    Rectangle source;
+    Rectangle dest;
+};
+
+// Testo già impaginato: un rettangolo dell'atlante dei glifi e la sua destinazione per ogni carattere
+struct GlyphRun
+{
+    static constexpr int MAX_GLYPHS = 64;
+
+    SpriteInstance glyphs[MAX_GLYPHS];
+    int count = 0;
+};
+
+// Lista degli sprite da disegnare nel frame, in ordine dal più lontano al più vicino
+class SpriteDrawList
+{
+public:
+    SpriteDrawList() { instances.reserve(1024); }
+
+    void clear() { instances.clear(); }
+    size_t size() const { return instances.size(); }
+    const std::vector<SpriteInstance> &getInstances() const { return instances; }
+
+    void add(const Rectangle &source, const Rectangle &dest) { instances.push_back({source, dest}); }
+
+private:
+    std::vector<SpriteInstance> instances;
+};
+
+#endif
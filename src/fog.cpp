@@ -0,0 +1,30 @@
+#include "fog.hpp"
+#include "util.hpp"
+
+void FogTable::update(size_t segments, float density) {
+    if (segments == factors.size() && density == currentDensity)
+        return;
+
+    factors.resize(segments);
+    for (size_t n = 0; n < segments; n++)
+        factors[n] = Util::exponentialFog(static_cast<float>(n) / static_cast<float>(segments), density);
+    currentDensity = density;
+}
+
+static inline Color Blend(Color color, Color fogColor, int weight) {
+    return Color{static_cast<unsigned char>(fogColor.r + (((color.r - fogColor.r) * weight) / 256)),
+                 static_cast<unsigned char>(fogColor.g + (((color.g - fogColor.g) * weight) / 256)),
+                 static_cast<unsigned char>(fogColor.b + (((color.b - fogColor.b) * weight) / 256)),
+                 color.a};
+}
+
+Colors FogTable::apply(const Colors &color, float fog) {
+    if (fog >= 1.0f)
+        return color;
+
+    int weight = static_cast<int>(fog * 256.0f);
+    return Colors{Blend(color.road, FOG.road, weight),
+                  Blend(color.grass, FOG.road, weight),
+                  Blend(color.rumble, FOG.road, weight),
+                  Blend(color.lane, FOG.road, weight)};
+}
@@ -0,0 +1,29 @@
+#ifndef __FOG_HPP__
+#define __FOG_HPP__
+
+#include <vector>
+#include <cstddef>
+
+#include "raylib.h"
+#include "common.hpp"
+
+// Tabella della nebbia esponenziale indicizzata dalla distanza in segmenti.
+// Il fattore vale 1 vicino alla camera (nessuna nebbia) e scende verso 0 alla
+// fine della distanza di disegno.
+class FogTable
+{
+public:
+    // Ricalcola la tabella solo se cambiano il numero di segmenti o la densità
+    void update(size_t segments, float density);
+
+    float operator[](size_t n) const { return factors[n]; }
+
+    // Colori del segmento miscelati con il colore della nebbia
+    static Colors apply(const Colors &color, float fog);
+
+private:
+    std::vector<float> factors;
+    float currentDensity = -1.0f;
+};
+
+#endif
@@ -21,36 +21,105 @@ void Game::saveScore() {
 }
 
 // Funzione di utilità per verificare se due oggetti si sovrappongono
-void Game::init() {
+void Game::init(const std::map<std::string, std::string> &overrides) {
     std::map <std::string, std::string> options = {};
     std::ifstream f("options.json");
     if (f.good()) {
         json data = json::parse(f);
         options = data.get < std::map < std::string, std::string >> ();
     }
+    // Un replay riporta le opzioni e il seme della partita registrata
+    if (overrides.count("replay")) {
+        if (replay.load(overrides.at("replay"))) {
+            options = replay.getOptions();
+            options["seed"] = std::to_string(replay.getSeed());
+            replaying = replay.steps() > 0;
+            printf("Replay: %zu steps in %zu runs\n", replay.steps(), replay.runCount());
+        } else {
+            printf("Cannot load replay %s\n", overrides.at("replay").c_str());
+        }
+    }
+    // Le opzioni della riga di comando hanno la precedenza
+    for (const auto &option: overrides)
+        options[option.first] = option.second;
     loadOptions(options);
 
-    // Inizializzazione della finestra
-    InitWindow(width, height, "OutRaylib");
-    SetTargetFPS(fps);
+    // La registrazione conserva le opzioni della partita, senza quelle della modalità di esecuzione
+    if (!recordFile.empty() && !replaying) {
+        for (const char *key: {"seed", "record", "replay", "headless", "headlessSeconds", "headlessLaps",
+                               "offscreenFrames"})
+            options.erase(key);
+        replay.start(seed, options);
+    }
+    timestep.setup(step, maxSubSteps);
+    trafficPool.reset(new ThreadPool(trafficThreads));
+    loadScore();
 
-    loadImages();
+    // Senza finestra, dispositivo grafico e audio: solo la simulazione
+    if (headless)
+        return;
+
+    // Inizializzazione della finestra (il backend nullo e quello software che non mostra
+    // il frame non ne hanno bisogno, e senza finestra non c'è nemmeno il limite dei frame)
+    if (!offscreen) {
+        if (vsync)
+            SetConfigFlags(FLAG_VSYNC_HINT);
+        InitWindow(width, height, "OutRaylib");
+        SetTargetFPS(targetFPS);
+    }
 
-    loadScore();
+    // Backend di disegno
+    if (renderer == "software")
+        drawing.reset(new SoftwareDrawing(softwarePresent, dumpFrames, dumpEvery, softwareThreads));
+    else if (renderer == "null")
+        drawing.reset(new NullDrawing());
+    else
+        drawing.reset(new RaylibDrawing());
+    drawing->LoadResources();
+
+    // Risoluzione interna: fissa, oppure regolata tra minRenderHeight e maxRenderHeight
+    setRenderHeight(maxRenderHeight);
+    if (dynamicResolution)
+        resolutionGovernor.setup(frameBudget / 1000.0f, static_cast<float>(std::min(minRenderHeight, maxRenderHeight)),
+                                 static_cast<float>(maxRenderHeight));
+
+    drawGovernor.setup(frameBudget / 1000.0f, static_cast<float>(std::min(minDrawDistance, maxDrawDistance)),
+                       static_cast<float>(maxDrawDistance));
+    if (!telemetryFile.empty()) {
+        telemetry = fopen(telemetryFile.c_str(), "w");
+        if (telemetry != nullptr)
+            fprintf(telemetry, "frame,update_ms,frame_ms,backend_ms,total_ms,average_ms,draw_distance,decision,"
+                               "render_height,resolution_decision,visible_sprites,culled_sprites\n");
+    }
+
+    if (offscreen)
+        return;
 
     audio.init();
     audio.loadTrack(tracks[0].c_str());
     audio.playTrack();
-
-    fontTtf = LoadFontEx("resources/font/Retroica.ttf", 24, 0, 250);
 }
 
 void Game::destroy() {
-    UnloadTexture(background);
-    UnloadTexture(sprites);
+    if (!recordFile.empty() && !replaying && replay.steps() > 0) {
+        if (replay.save(recordFile))
+            printf("Recorded %zu steps in %zu runs to %s\n", replay.steps(), replay.runCount(), recordFile.c_str());
+        else
+            printf("Cannot write replay %s\n", recordFile.c_str());
+    }
+
+    if (headless)
+        return;
 
-    audio.destroy();
-    UnloadFont(fontTtf);
+    drawing->UnloadResources();
+
+    if (telemetry != nullptr) {
+        fclose(telemetry);
+        telemetry = nullptr;
+    }
+
+    if (!offscreen)
+        audio.destroy();
 }
 
 void Game::updateAudioTrack() {
@@ -62,12 +131,33 @@ void Game::unloadAudioTrack() {
 }
 
 void Game::update() {
-    Segment &playerSegment = findSegment(position + playerZ);
+    auto updateStart = std::chrono::steady_clock::now();
+
+    // Gli ingressi del passo arrivano dal replay, oppure vengono registrati
+    if (replaying) {
+        unsigned char input = 0;
+        replay.next(input);
+        keyLeft = (input & Replay::LEFT) != 0;
+        keyRight = (input & Replay::RIGHT) != 0;
+        keyFaster = (input & Replay::FASTER) != 0;
+        keySlower = (input & Replay::SLOWER) != 0;
+    } else if (!recordFile.empty()) {
+        replay.record(static_cast<unsigned char>((keyLeft ? Replay::LEFT : 0) | (keyRight ? Replay::RIGHT : 0) |
+                                                 (keyFaster ? Replay::FASTER : 0) | (keySlower ? Replay::SLOWER : 0)));
+    }
+    size_t playerSegment = findSegment(position + playerZ);
+    float playerCurve = road.curve(playerSegment);
     float playerW = SPRITES::PLAYER_STRAIGHT.w * SPRITE_SCALE;
     float speedPercent = speed / maxSpeed;
     float dx = step * 2.0f * speedPercent; // Velocità laterale massima
     float startPosition = position;
 
+    previousPosition = position;
+    previousPlayerX = playerX;
+    previousSkyOffset = skyOffset;
+    previousHillOffset = hillOffset;
+    previousTreeOffset = treeOffset;
+
     // Aggiorna le auto
     updateCars(step, playerSegment, playerW);
 
@@ -82,7 +172,7 @@ void Game::update() {
     }
 
     // Effetto centrifugo
-    playerX -= dx * speedPercent * playerSegment.curve * centrifugal;
+    playerX -= dx * speedPercent * playerCurve * centrifugal;
 
     // Aggiorna la velocità del giocatore
     if (keyFaster) {
@@ -100,24 +190,25 @@ void Game::update() {
         }
 
         // Controlla collisioni con sprite
-        for (const auto &sprite: playerSegment.sprites) {
-            float spriteW = sprite.w * SPRITE_SCALE;
-            if (Util::overlap(playerX, playerW, sprite.offset + spriteW / 2.0f * (sprite.offset > 0 ? 1 : -1),
+        const Sprite *spritesEnd = road.spritesEnd(playerSegment);
+        for (const Sprite *sprite = road.spritesBegin(playerSegment); sprite != spritesEnd; sprite++) {
+            float spriteW = sprite->w * SPRITE_SCALE;
+            if (Util::overlap(playerX, playerW, sprite->offset + spriteW / 2.0f * (sprite->offset > 0 ? 1 : -1),
                               spriteW)) {
                 speed = maxSpeed / 5.0f;
-                position = Util::increase(playerSegment.p1.world.z, -playerZ, trackLength);
+                position = Util::increase(road.z(playerSegment), -playerZ, trackLength);
                 break;
             }
         }
     }
 
     // Controlla collisioni con altre auto
-    for (const auto &car: playerSegment.cars) {
-        float carW = car.sprite.w * SPRITE_SCALE;
-        if (speed > car.speed) {
-            if (Util::overlap(playerX, playerW, car.offset, carW, 0.8f)) {
-                speed = car.speed * (car.speed / speed);
-                position = Util::increase(car.z, -playerZ, trackLength);
+    for (unsigned int car = traffic.first(playerSegment); car != Traffic::NONE; car = traffic.next(car)) {
+        float carW = traffic.sprite(car).w * SPRITE_SCALE;
+        if (speed > traffic.speed[car]) {
+            if (Util::overlap(playerX, playerW, traffic.offset[car], carW, 0.8f)) {
+                speed = traffic.speed[car] * (traffic.speed[car] / speed);
+                position = Util::increase(traffic.z[car], -playerZ, trackLength);
                 break;
             }
         }
@@ -128,87 +219,257 @@ void Game::update() {
     speed = Util::limit(speed, 0.0f, maxSpeed);
 
     // Aggiorna gli offset per lo sfondo
-    skyOffset = Util::increase(skyOffset, skySpeed * playerSegment.curve * (position - startPosition) / segmentLength,
+    skyOffset = Util::increase(skyOffset, skySpeed * playerCurve * (position - startPosition) / segmentLength,
                                1.0f);
     hillOffset = Util::increase(hillOffset,
-                                hillSpeed * playerSegment.curve * (position - startPosition) / segmentLength, 1.0f);
+                                hillSpeed * playerCurve * (position - startPosition) / segmentLength, 1.0f);
     treeOffset = Util::increase(treeOffset,
-                                treeSpeed * playerSegment.curve * (position - startPosition) / segmentLength, 1.0f);
+                                treeSpeed * playerCurve * (position - startPosition) / segmentLength, 1.0f);
 
     if (position > playerZ) {
         if (currentLapTime && (startPosition < playerZ)) {
             lastLapTime = currentLapTime;
             currentLapTime = 0;
 
+            laps++;
+
+            // In modalità headless e durante un replay il record del giocatore non viene toccato
             if (lastLapTime <= fastestLapTime || fastestLapTime == 0.0f) {
                 fastestLapTime = lastLapTime;
-                saveScore();
-                updateHUD("fast_lap_time", Util::formatTime(lastLapTime));
+                if (!headless && !replaying)
+                    saveScore();
             }
-
-            updateHUD("last_lap_time", Util::formatTime(lastLapTime));
         } else {
             currentLapTime += step;
         }
     }
+
+    updateTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - updateStart).count();
+
+    // Finito il replay gli ingressi tornano alla tastiera
+    if (replaying && replay.finished()) {
+        replaying = false;
+        printf("Replay finished after %zu steps, state hash %016llx\n", replay.steps(),
+               static_cast<unsigned long long>(stateHash()));
+    }
 }
 
-float Game::lastY() {
-    if (segments.empty())
-        return 0.0f;
-    return segments.back().p2.world.y;
+// Pilota automatico della modalità headless: accelera sempre e sceglie la corsia
+// più vicina senza auto più lente nei prossimi segmenti
+void Game::autopilot() {
+    size_t playerSegment = findSegment(position + playerZ);
+    float playerW = SPRITES::PLAYER_STRAIGHT.w * SPRITE_SCALE;
+    float target = playerX;
+    float best = -1.0f;
+
+    for (int lane = 0; lane < lanes; lane++) {
+        float laneX = -1.0f + (2.0f * lane + 1.0f) / lanes;
+        bool blocked = false;
+
+        for (size_t i = 1; i < trafficLookahead && !blocked; i++) {
+            size_t segment = (playerSegment + i) % road.size();
+            for (unsigned int car = traffic.first(segment); car != Traffic::NONE; car = traffic.next(car)) {
+                float carW = traffic.sprite(car).w * SPRITE_SCALE;
+                if (traffic.speed[car] < speed && Util::overlap(laneX, playerW, traffic.offset[car], carW, 1.2f)) {
+                    blocked = true;
+                    break;
+                }
+            }
+        }
+
+        float distance = std::fabs(laneX - playerX);
+        if (!blocked && (best < 0.0f || distance < best)) {
+            best = distance;
+            target = laneX;
+        }
+    }
+
+    keyFaster = true;
+    keySlower = false;
+    keyLeft = playerX > target + 0.05f;
+    keyRight = playerX < target - 0.05f;
 }
 
-void Game::updateHUD(std::string key, std::string value) {
-    std::stringstream text;
-    if (key == "speed") {
-        text << value << " Mph";
-        DrawTextEx(fontTtf, text.str().c_str(), Vector2{width - 150.0f, 20.0f}, (float) fontTtf.baseSize, 1, BLACK);
-    } else if (key == "current_lap_time") {
-        text << "Time: " << value;
-        DrawTextEx(fontTtf, text.str().c_str(), Vector2{20.0f, 20.0f}, (float) fontTtf.baseSize, 1, BLACK);
-    } else if (key == "fastest_lap_time") {
-        text << "Fastest Lap: " << value;
-        DrawTextEx(fontTtf, text.str().c_str(), Vector2{width / 3.0f - 140, 20.0f}, (float) fontTtf.baseSize, 1, BLACK);
-    } else if (key == "last_lap_time")
-        DrawTextEx(fontTtf, value.c_str(), Vector2{width / 2.0f + 70.0f, 20.0f}, (float) fontTtf.baseSize, 1, BLACK);
+// Simula senza finestra il più velocemente possibile per headlessSeconds secondi
+// simulati (o headlessLaps giri) e riporta il throughput e i tempi delle fasi
+int Game::runHeadless() {
+    if (steeringBenchmark)
+        return benchSteering();
+
+    unsigned long long maxSteps = static_cast<unsigned long long>(headlessSeconds * fps);
+    unsigned long long steps = 0;
+    bool fromReplay = replaying;
+    updateTime = windowTime = trafficTime = commitTime = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    // Con un replay la durata è quella della registrazione
+    while (fromReplay ? replaying
+                      : ((headlessLaps > 0 && laps < headlessLaps) || (headlessLaps <= 0 && steps < maxSteps))) {
+        if (!fromReplay)
+            autopilot();
+        update();
+        steps++;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double simulated = steps * static_cast<double>(step);
+    double n = static_cast<double>(std::max(1ull, steps));
+    printf("Headless: %llu steps, %.1f s simulated in %.3f s (%.0f steps/s, %.0fx real time)\n", steps, simulated,
+           wall, steps / std::max(wall, 1e-9), simulated / std::max(wall, 1e-9));
+    printf("  laps: %d, fastest lap: %.1f s, cars: %zu (%zu simulated at the end)\n", laps, fastestLapTime,
+           traffic.size(), traffic.nearCount());
+    printf("  us/step: update %.2f, traffic window %.2f, traffic step %.2f, traffic commit %.2f, player %.2f\n",
+           1e6 * updateTime / n, 1e6 * windowTime / n, 1e6 * trafficTime / n, 1e6 * commitTime / n,
+           1e6 * (updateTime - windowTime - trafficTime - commitTime) / n);
+    printf("  state hash: %016llx\n", static_cast<unsigned long long>(stateHash()));
+    return 0;
 }
 
-void Game::renderHUD() {
-    // Draw HUD Rectangle
-    DrawRectangle(0, 0, width, 60, Color{0xFF, 0x00, 0x00, 127});
-    DrawRectangleLines(0, 0, width, 60, BLACK);
+// Disegna offscreenFrames frame senza finestra (backend nullo o software senza present):
+// il tempo reale viene dal clock di sistema e il giocatore è guidato dal pilota
+// automatico (o dal replay)
+int Game::runOffscreen() {
+    auto start = std::chrono::steady_clock::now();
+    auto previous = start;
+    for (int n = 0; n < offscreenFrames; n++) {
+        auto now = std::chrono::steady_clock::now();
+        if (!replaying)
+            autopilot();
+        advance(std::chrono::duration<double>(now - previous).count());
+        previous = now;
+
+        frame();
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    // Time
-    DrawRectangle(10, 10, 160, 40, Color{0xFF, 0xFF, 0xFF, 127});
-    DrawRectangleLines(10, 10, 160, 40, BLACK);
+    printf("Offscreen: %d frames in %.3f s (%.1f FPS)\n", offscreenFrames, wall,
+           offscreenFrames / std::max(wall, 1e-9));
+    printf("  state hash: %016llx\n", static_cast<unsigned long long>(stateHash()));
+    return 0;
+}
 
-    // Speed
-    DrawRectangle(width - 160, 10, 160, 40, Color{0xFF, 0xFF, 0xFF, 127});
-    DrawRectangleLines(width - 160, 10, 160, 40, BLACK);
+// Hash dello stato della simulazione, per verificare che due esecuzioni siano identiche
+uint64_t Game::stateHash() const {
+    float player[] = {position, playerX, speed, currentLapTime, lastLapTime};
+    uint64_t h = Util::hash(player, sizeof(player));
+    h = Util::hash(traffic.z.data(), traffic.z.size() * sizeof(float), h);
+    h = Util::hash(traffic.offset.data(), traffic.offset.size() * sizeof(float), h);
+    return Util::hash(traffic.speed.data(), traffic.speed.size() * sizeof(float), h);
+}
 
-    // Current Lap
-    DrawRectangle(width / 3 - 150, 10, 250, 40, Color{0xFF, 0xFF, 0xFF, 127});
-    DrawRectangleLines(width / 3 - 150, 10, 250, 40, BLACK);
+// Microbenchmark dello sterzo del traffico (un thread): a ogni passo misura la ricerca
+// lungo l'anello (senza copie) e il kernel (scalare e vettoriale, compresa la copia in
+// ordine di z) sulle stesse auto vicine, e controlla che diano lo stesso risultato.
+// Il riferimento è la ricerca sull'anello, non la scansione per segmenti originale.
+int Game::benchSteering() {
+    const int warmup = 600;                 // Passi prima delle misure (le auto si distribuiscono)
+    const int samples = 600;                // Passi misurati
+    const int repeats = 20;                 // Ripetizioni per passo
+    float playerReach = Steering::reach(SPRITES::PLAYER_STRAIGHT.w * SPRITE_SCALE);
+    std::vector<float> expected, scalar, vector;
+    double referenceTime = 0.0, scalarTime = 0.0, vectorTime = 0.0;
+    unsigned long long cars = 0, mismatches = 0;
+
+    for (int s = 0; s < warmup; s++) {
+        autopilot();
+        update();
+    }
+
+    for (int s = 0; s < samples; s++) {
+        autopilot();
+        update();
+
+        size_t playerSegment = findSegment(position + playerZ);
+        size_t count = traffic.nearCount();
+        expected.resize(count);
+        scalar.resize(count);
+        vector.resize(count);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+            for (size_t k = 0; k < count; k++)
+                expected[k] = steerCar(traffic.nearCar(k), playerSegment, playerReach, Steering::RING);
+
+        auto t1 = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) {
+            steering.build(traffic, carReach);
+            for (size_t k = 0; k < count; k++)
+                scalar[k] = steerCar(traffic.nearCar(k), playerSegment, playerReach, Steering::SCALAR);
+        }
 
-    // Fastest Lap
-    DrawRectangle((width / 2) + 70, 10, 250, 40, Color{0xFF, 0xFF, 0xFF, 127});
-    DrawRectangleLines((width / 2) + 70, 10, 250, 40, BLACK);
+        auto t2 = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) {
+            steering.build(traffic, carReach);
+            for (size_t k = 0; k < count; k++)
+                vector[k] = steerCar(traffic.nearCar(k), playerSegment, playerReach);
+        }
+        auto t3 = std::chrono::steady_clock::now();
 
-    updateHUD("speed", std::to_string(static_cast<int>(5 * round(speed / 500))));
-    updateHUD("current_lap_time", Util::formatTime(currentLapTime));
-    updateHUD("fastest_lap_time", Util::formatTime(fastestLapTime));
+        referenceTime += std::chrono::duration<double>(t1 - t0).count();
+        scalarTime += std::chrono::duration<double>(t2 - t1).count();
+        vectorTime += std::chrono::duration<double>(t3 - t2).count();
+        cars += count * repeats;
+
+        for (size_t k = 0; k < count; k++)
+            if (std::memcmp(&expected[k], &scalar[k], sizeof(float)) != 0 ||
+                std::memcmp(&expected[k], &vector[k], sizeof(float)) != 0)
+                mismatches++;
+    }
+
+    printf("Steering: %.1f cars simulated per step, %s kernel\n", static_cast<double>(cars) / repeats / samples,
+           Steering::kernelName());
+    printf("  ring (scalar, no copy): %.2f cars/us\n", cars / (1e6 * std::max(referenceTime, 1e-9)));
+    printf("  scalar kernel: %.2f cars/us\n", cars / (1e6 * std::max(scalarTime, 1e-9)));
+    printf("  %s kernel: %.2f cars/us\n", Steering::kernelName(),
+           cars / (1e6 * std::max(vectorTime, 1e-9)));
+    printf("  mismatches: %llu\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
 }
 
-/* Main game functions */
-void Game::loadImages() {
-    Image image = LoadImage("resources/images/background.png"); // Loaded in CPU memory (RAM)
-    background = LoadTextureFromImage(image);                   // Image converted to texture, GPU memory (VRAM)
-    image = LoadImage("resources/images/sprites.png");
-    sprites = LoadTextureFromImage(image);
-    UnloadImage(image);
+// Esegue gli update a passo fisso per il tempo reale trascorso dall'ultimo frame
+void Game::advance(double elapsed) {
+    int steps = timestep.advance(elapsed);
+    for (int s = 0; s < steps; s++)
+        update();
 }
 
+float Game::lastY() {
+    return road.lastY();
+}
+
+void Game::renderHUD() {
+    hud.setNumber(Hud::SPEED, static_cast<int>(5 * round(speed / 500)));
+    hud.setTime(Hud::CURRENT_LAP, currentLapTime);
+    hud.setTime(Hud::FASTEST_LAP, fastestLapTime);
+    hud.render(*drawing, width);
+}
+
+void Game::renderStats() {
+    char text[128];
+
+    snprintf(text, sizeof(text), "Road (%s): %d quads, %d draw calls", scanlineRoad ? "scanline" : "polygon",
+             drawing->GetRoadQuads(), drawing->GetRoadDrawCalls());
+    drawing->DrawText(text, 10.0f, height - 55.0f, BLACK);
+    snprintf(text, sizeof(text), "Sprites: %d, %d draw calls, %d culled", drawing->GetSprites(),
+             drawing->GetSpriteDrawCalls(), culledSprites);
+    drawing->DrawText(text, 10.0f, height - 80.0f, BLACK);
+    snprintf(text, sizeof(text), "Traffic: %zu simulated of %zu cars", traffic.nearCount(), traffic.size());
+    drawing->DrawText(text, 10.0f, height - 155.0f, BLACK);
+
+    if (drawGovernor.enabled()) {
+        const char *decision = drawGovernor.decision() == Governor::DOWN ? "down" :
+                               drawGovernor.decision() == Governor::UP ? "up" : "hold";
+        snprintf(text, sizeof(text), "Governor: distance %zu, %.2f / %.2f ms (%s)", drawDistance,
+                 1000.0f * drawGovernor.average(), frameBudget, decision);
+        drawing->DrawText(text, 10.0f, height - 105.0f, BLACK);
+    }
+    if (renderHeight != height || resolutionGovernor.enabled()) {
+        snprintf(text, sizeof(text), "Scene: %dx%d", renderWidth, renderHeight);
+        drawing->DrawText(text, 10.0f, height - 130.0f, BLACK);
+    }
+}
+
+/* Main game functions */
 void Game::pollKeys() {
     keyLeft = keyRight = keyFaster = keySlower = false;
     if (!paused) {
@@ -246,123 +507,295 @@ void Game::pollKeys() {
     }
     if (IsKeyPressed(KEY_SPACE))
         togglePause();
+
+    if (IsKeyPressed(KEY_TAB))
+        showStats = !showStats;
 }
 
 void Game::togglePause() {
     paused = !paused;
 }
 
+// Accoda la strada tra i punti proiettati from e to (un segmento o un gruppo accorpato dal LOD)
+void Game::drawRoadSegment(size_t from, size_t to, unsigned char color, float clipY) {
+    const float *screenX = projection.screenX.data();
+    const float *screenY = projection.screenY.data();
+    const float *screenW = projection.screenW.data();
+
+    if (scanlineRoad)
+        roadLines.addSegment(screenX[from], screenY[from], screenW[from], screenX[to], screenY[to], screenW[to], color,
+                             fogTable[from], clipY);
+    else
+        drawing->DrawSegment(renderWidth, lanes,
+                            screenX[from],
+                            screenY[from],
+                            screenW[from],
+                            screenX[to],
+                            screenY[to],
+                            screenW[to],
+                            fogTable[from],
+                            SEGMENT_COLORS[color]);
+}
+
+// Imposta l'altezza della scena (multipla di 8) e la larghezza con le proporzioni della finestra
+void Game::setRenderHeight(int _renderHeight) {
+    if (_renderHeight >= height) {
+        renderWidth = width;
+        renderHeight = height;
+    } else {
+        renderHeight = std::max(8, _renderHeight / 8 * 8);
+        renderWidth = std::max(8, (renderHeight * width + height / 2) / height);
+    }
+}
+
+// Passa al regolatore il tempo CPU del frame appena finito e scrive la telemetria
+void Game::governFrame(double frameTime) {
+    double backendTime = drawing->GetBackendTime();
+    double total = updateTime + frameTime + backendTime;
+
+    // I due regolatori leggono lo stesso tempo: per non correggere due volte lo stesso
+    // sforamento si scende prima con la distanza e poi con la risoluzione, e si risale
+    // prima con la risoluzione e poi con la distanza
+    bool lowerResolution = !drawGovernor.enabled() || drawGovernor.atMin();
+    bool raiseDistance = !resolutionGovernor.enabled() || resolutionGovernor.atMax();
+
+    if (drawGovernor.enabled())
+        drawDistance = static_cast<size_t>(drawGovernor.update(static_cast<float>(total), true, raiseDistance) + 0.5f);
+    if (resolutionGovernor.enabled())
+        setRenderHeight(static_cast<int>(resolutionGovernor.update(static_cast<float>(total), lowerResolution, true)));
+
+    if (telemetry != nullptr)
+        fprintf(telemetry, "%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%zu,%d,%d,%d,%d,%d\n", frameCount, 1000.0 * updateTime,
+                1000.0 * frameTime, 1000.0 * backendTime, 1000.0 * total, 1000.0 * drawGovernor.average(),
+                drawDistance, static_cast<int>(drawGovernor.decision()), renderHeight,
+                static_cast<int>(resolutionGovernor.decision()), visibleSprites, culledSprites);
+
+    frameCount++;
+    updateTime = 0.0;
+}
+
 void Game::frame() {
-    unsigned int i;
+    auto frameStart = std::chrono::steady_clock::now();
     size_t n;
-    Sprite sprite;
-    Car car;
     float spriteScale, spriteX, spriteY;
 
-    Segment &baseSegment = findSegment(position);
-    float basePercent = Util::percentRemaining(position, segmentLength);
-    Segment &playerSegment = findSegment(position + playerZ);
-    float playerPercent = Util::percentRemaining(position + playerZ, segmentLength);
-    float playerY = Util::interpolate(playerSegment.p1.world.y, playerSegment.p2.world.y, playerPercent);
-    float maxy = static_cast<float>(height);
+    // Il ciclo degli sprite parte da drawDistance - 1: servono almeno due segmenti
+    drawDistance = std::max<size_t>(drawDistance, 2);
+
+    // Stato da disegnare: interpolato tra gli ultimi due passi della simulazione
+    float alpha = timestep.alpha();
+    float cameraPosition = Util::interpolateWrapped(previousPosition, position, alpha, trackLength);
+    float cameraX = Util::interpolate(previousPlayerX, playerX, alpha);
+    float skyRotation = Util::interpolateWrapped(previousSkyOffset, skyOffset, alpha, 1.0f);
+    float hillRotation = Util::interpolateWrapped(previousHillOffset, hillOffset, alpha, 1.0f);
+    float treeRotation = Util::interpolateWrapped(previousTreeOffset, treeOffset, alpha, 1.0f);
+
+    size_t baseSegment = findSegment(cameraPosition);
+    float basePercent = Util::percentRemaining(cameraPosition, segmentLength);
+    size_t playerSegment = findSegment(cameraPosition + playerZ);
+    float playerPercent = Util::percentRemaining(cameraPosition + playerZ, segmentLength);
+    float playerY = Util::interpolate(road.startY(playerSegment), road.endY(playerSegment), playerPercent);
+    float maxy = static_cast<float>(renderHeight);
+    resolution = static_cast<float>(renderHeight) / 480.0f;
 
     // Rendering
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
+    drawing->BeginFrame(renderWidth, renderHeight);
 
-    drawing.DrawBackground(background, width, height, BACKGROUND::SKY, skyOffset, resolution * skySpeed * playerY);
-    drawing.DrawBackground(background, width, height, BACKGROUND::HILLS, hillOffset, resolution * hillSpeed * playerY);
-    drawing.DrawBackground(background, width, height, BACKGROUND::TREES, treeOffset, resolution * treeSpeed * playerY);
+    drawing->DrawBackground(renderWidth, renderHeight, BACKGROUND::LAYER_SKY, skyRotation, resolution * skySpeed * playerY);
+    drawing->DrawBackground(renderWidth, renderHeight, BACKGROUND::LAYER_HILLS, hillRotation, resolution * hillSpeed * playerY);
+    drawing->DrawBackground(renderWidth, renderHeight, BACKGROUND::LAYER_TREES, treeRotation, resolution * treeSpeed * playerY);
 
-    float x = 0.0f;
-    float dx = -(baseSegment.curve * basePercent);
+    size_t total = road.size();
+    size_t playerN = (playerSegment + total - baseSegment) % total;
+
+    // Prepara le coordinate camera di tutti i confini dei segmenti (drawDistance + 1 punti)
+    projection.resize(drawDistance + 1);
+
+    // Ogni punto è indipendente dagli altri: lo spostamento dovuto alle curve arriva
+    // dalle somme prefisse della strada invece che da un accumulo lungo il ciclo
+    for (n = 0; n <= drawDistance; n++) {
+        size_t index = (baseSegment + n) % total;
+        projection.looped[n] = static_cast<unsigned char>((baseSegment + n) / total); // Giri oltre il traguardo
+
+        projection.cameraX[n] = road.curveOffset(baseSegment, basePercent, n) - (cameraX * roadWidth);
+        projection.cameraY[n] = road.startY(index) - (playerY + cameraHeight);
+        projection.cameraZ[n] = road.z(index) - (cameraPosition - projection.looped[n] * trackLength);
+    }
+
+    projection.project(cameraDepth, static_cast<float>(renderWidth), static_cast<float>(renderHeight), roadWidth);
+
+    const float *cameraZ = projection.cameraZ.data();
+    const float *screenX = projection.screenX.data();
+    const float *screenY = projection.screenY.data();
+    const float *screenScale = projection.screenScale.data();
+
+    float *clip = projection.clip.data();
+
+    // La tabella viene ricalcolata solo quando cambiano la distanza di disegno o la densità
+    fogTable.update(drawDistance, fogDensity);
+
+    if (scanlineRoad)
+        roadLines.reset(renderHeight);
+
+    // LOD della strada: segmenti consecutivi più bassi di lodPixels vengono accorpati
+    // in un unico quadrilatero dal punto first al punto last + 1
+    bool merging = false;
+    size_t mergeFirst = 0, mergeLast = 0;
+    unsigned char mergeColor = 0;
+    float mergeClip = maxy;
 
     for (n = 0; n < drawDistance; n++) {
-        Segment &segment = segments[(baseSegment.index + n) % segments.size()];
-        segment.looped = segment.index < baseSegment.index;
-        segment.fog = Util::exponentialFog(static_cast<float>(n / drawDistance), fogDensity);
-        segment.clip = maxy;
-
-        Util::project(segment.p1, (playerX * roadWidth) - x, playerY + cameraHeight,
-                      position - (segment.looped ? trackLength : 0.0f), cameraDepth, static_cast<float>(width), static_cast<float>(height), roadWidth);
-        Util::project(segment.p2, (playerX * roadWidth) - x - dx, playerY + cameraHeight,
-                      position - (segment.looped ? trackLength : 0.0f), cameraDepth, static_cast<float>(width), static_cast<float>(height), roadWidth);
-
-        x = x + dx;
-        dx = dx + segment.curve;
-
-        if ((segment.p1.camera.z <= cameraDepth) ||         // behind us
-            (segment.p2.screen.y >= segment.p1.screen.y) || // back face cull
-            (segment.p2.screen.y >= maxy))                  // clip by (already rendered) hill
+        clip[n] = maxy;
+
+        // Un segmento alto zero pixel non viene scartato se allunga un gruppo: non ne cambia l'aspetto
+        bool flat = merging && screenY[n + 1] == screenY[n];
+
+        if ((cameraZ[n] <= cameraDepth) ||                  // behind us
+            (screenY[n + 1] >= screenY[n] && !flat) ||      // back face cull
+            (screenY[n + 1] >= maxy)) {                     // clip by (already rendered) hill
+            if (merging)
+                drawRoadSegment(mergeFirst, mergeLast + 1, mergeColor, mergeClip);
+            merging = false;
+            continue;
+        }
+
+        if (flat) {
+            mergeLast = n;
+            maxy = screenY[n];
             continue;
+        }
 
-        drawing.DrawSegment(width, lanes,
-                            segment.p1.screen.x,
-                            segment.p1.screen.y,
-                            segment.p1.screen.w,
-                            segment.p2.screen.x,
-                            segment.p2.screen.y,
-                            segment.p2.screen.w,
-                            segment.fog,
-                            segment.color);
+        unsigned char color = road.color((baseSegment + n) % total);
+        float segmentHeight = screenY[n] - screenY[n + 1];
 
-        maxy = segment.p1.screen.y;
+        // Un cambio di colore interrompe l'accorpamento solo se la banda precedente è visibile (almeno un pixel)
+        if (merging && segmentHeight < lodPixels &&
+            (color == mergeColor || screenY[mergeFirst] - screenY[n] < 1.0f) &&
+            screenY[mergeFirst] - screenY[n + 1] <= lodPixels) {
+            mergeLast = n;
+        } else {
+            if (merging)
+                drawRoadSegment(mergeFirst, mergeLast + 1, mergeColor, mergeClip);
+            merging = segmentHeight < lodPixels;
+
+            if (merging) {
+                mergeFirst = mergeLast = n;
+                mergeColor = color;
+                mergeClip = maxy;
+            } else {
+                drawRoadSegment(n, n + 1, color, maxy);
+            }
+        }
+
+        maxy = screenY[n];
     }
 
+    if (merging)
+        drawRoadSegment(mergeFirst, mergeLast + 1, mergeColor, mergeClip);
+
+    if (scanlineRoad)
+        drawing->DrawRoadLines(renderWidth, lanes, roadLines);
+
+    drawing->FlushRoad();
+
+    // Culling degli sprite: il rettangolo sullo schermo viene calcolato una sola volta e
+    // scartato se è fuori dallo schermo o sotto la riga di taglio del segmento
+    Rectangle sourceRec, destRec;
+    visibleSprites = culledSprites = 0;
+
     for (n = (drawDistance - 1); n > 0; n--) {
-        Segment &segment = segments[(baseSegment.index + n) % segments.size()];
-
-        for (i = 0; i < segment.cars.size(); i++) {
-            car = segment.cars[i];
-            sprite = car.sprite;
-            spriteScale = Util::interpolate(segment.p1.screen.scale, segment.p2.screen.scale, car.percent);
-            spriteX = Util::interpolate(segment.p1.screen.x, segment.p2.screen.x, car.percent) +
-                      (spriteScale * car.offset * roadWidth * width / 2);
-            spriteY = Util::interpolate(segment.p1.screen.y, segment.p2.screen.y, car.percent);
-            drawing.DrawSprite(sprites, width, height, resolution, roadWidth, sprite, spriteScale, spriteX, spriteY,
-                               -0.5, -1, segment.clip);
-        }
+        size_t index = (baseSegment + n) % total;
+
+        // Segmento dietro la camera: nessuno dei suoi sprite è visibile
+        if (cameraZ[n] <= cameraDepth) {
+            for (unsigned int car = traffic.first(index); car != Traffic::NONE; car = traffic.next(car))
+                culledSprites++;
+            culledSprites += static_cast<int>(road.spritesEnd(index) - road.spritesBegin(index));
+        } else {
+            // Le auto sono disegnate nella posizione interpolata come la camera. In un passo
+            // un'auto avanza al massimo di un segmento: quelle da disegnare qui sono nella
+            // lista di questo segmento o in quella del successivo.
+            size_t nextIndex = (index + 1) % total;
+            for (size_t list = index;; list = nextIndex) {
+                for (unsigned int car = traffic.first(list); car != Traffic::NONE; car = traffic.next(car)) {
+                    float carZ = Util::interpolateWrapped(traffic.previousZ(car), traffic.z[car], alpha, trackLength);
+                    if (findSegment(carZ) != index)
+                        continue;
+
+                    float percent = Util::percentRemaining(carZ, segmentLength);
+                    float carOffset = Util::interpolate(traffic.previousOffset(car), traffic.offset[car], alpha);
+                    spriteScale = Util::interpolate(screenScale[n], screenScale[n + 1], percent);
+                    spriteX = Util::interpolate(screenX[n], screenX[n + 1], percent) +
+                              (spriteScale * carOffset * roadWidth * renderWidth / 2);
+                    spriteY = Util::interpolate(screenY[n], screenY[n + 1], percent);
+                    if (Drawing::SpriteRect(renderWidth, renderHeight, roadWidth, traffic.sprite(car), spriteScale,
+                                            spriteX, spriteY,
+                                            -0.5f, -1.0f, clip[n], sourceRec, destRec)) {
+                        drawing->DrawSprite(sourceRec, destRec);
+                        visibleSprites++;
+                    } else {
+                        culledSprites++;
+                    }
+                }
+                if (list == nextIndex)
+                    break;
+            }
 
-        for (i = 0; i < segment.sprites.size(); i++) {
-            sprite = segment.sprites[i];
-            spriteScale = segment.p1.screen.scale;
-            spriteX = segment.p1.screen.x + (spriteScale * sprite.offset * roadWidth * width / 2);
-            spriteY = segment.p1.screen.y;
-            drawing.DrawSprite(sprites, width, height, resolution, roadWidth, sprite, spriteScale, spriteX, spriteY,
-                               (sprite.offset < 0.0f ? -1.0f : 0.0f), -1, segment.clip);
+            for (const Sprite *it = road.spritesBegin(index); it != road.spritesEnd(index); it++) {
+                spriteScale = screenScale[n];
+                spriteX = screenX[n] + (spriteScale * it->offset * roadWidth * renderWidth / 2);
+                spriteY = screenY[n];
+                if (Drawing::SpriteRect(renderWidth, renderHeight, roadWidth, *it, spriteScale, spriteX, spriteY,
+                                        (it->offset < 0.0f ? -1.0f : 0.0f), -1.0f, clip[n], sourceRec, destRec)) {
+                    drawing->DrawSprite(sourceRec, destRec);
+                    visibleSprites++;
+                } else {
+                    culledSprites++;
+                }
+            }
         }
 
-        if (&segment == &playerSegment) {
-            drawing.DrawPlayer(sprites, width, height, resolution, roadWidth, speed / maxSpeed,
+        if (n == playerN) {
+            drawing->DrawPlayer(renderWidth, renderHeight, resolution, roadWidth, speed / maxSpeed,
                                cameraDepth / playerZ,
-                               static_cast<float>(width / 2),
-                               (height / 2) - (cameraDepth / playerZ *
-                                               Util::interpolate(playerSegment.p1.camera.y, playerSegment.p2.camera.y,
-                                                                 playerPercent) * height / 2),
+                               static_cast<float>(renderWidth / 2),
+                               (renderHeight / 2) - (cameraDepth / playerZ *
+                                               Util::interpolate(projection.cameraY[n], projection.cameraY[n + 1],
+                                                                 playerPercent) * renderHeight / 2),
                                speed * (keyLeft ? -1.0f : keyRight ? 1.0f : 0.0f),
-                               playerSegment.p2.world.y - playerSegment.p1.world.y,
-                               paused);
+                               road.endY(playerSegment) - road.startY(playerSegment),
+                               paused, jitterRandom);
         }
     }
 
+    drawing->FlushSprites();
+
+    // L'HUD viene disegnato alla risoluzione della finestra
+    drawing->BeginOverlay(width, height);
+
     renderHUD();
 
     if (paused) {
-        DrawRectangle(width / 2 - 100, height / 2 - 50, 200, 40, Color{0xFF, 0xFF, 0xFF, 220});
-        DrawTextEx(fontTtf, "Game Paused", Vector2{width / 2 - 90.0f, height / 2 - 40.0f}, (float) fontTtf.baseSize, 1,
-                   BLACK);
+        drawing->DrawRectangle(width / 2 - 100, height / 2 - 50, 200, 40, Color{0xFF, 0xFF, 0xFF, 220});
+        drawing->DrawText("Game Paused", width / 2 - 90.0f, height / 2 - 40.0f, BLACK);
     }
-    DrawFPS(10, height - 30);
+    if (showStats)
+        renderStats();
+
+    drawing->DrawFPS(10, height - 30);
+
+    double frameTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+    drawing->EndFrame();
 
-    EndDrawing();
+    governFrame(frameTime);
 }
 
 void Game::addSprite(size_t n, Sprite sprite, float offset) {
-    if (n >= 0 && n < segments.size()) {
+    if (n < road.size()) {
         sprite.source = {sprite.x, sprite.y, sprite.w, sprite.h};
         sprite.offset = offset;
         // Aggiungi lo sprite al segmento
-        segments[n].sprites.push_back(sprite);
+        road.addSprite(n, sprite);
     }
 }
 
@@ -447,83 +880,94 @@ void Game::addDownhillToEnd(int num = 200) {
 }
 
 // Funzione per aggiornare la posizione delle auto
-void Game::updateCars(float dt, Segment &playerSegment, float playerW) {
-    for (auto &car: cars) {
-        // Trova il segmento attuale dell'auto
-        Segment &oldSegment = findSegment(car.z);
+void Game::updateCars(float dt, size_t playerSegment, float playerW) {
+    auto windowStart = std::chrono::steady_clock::now();
 
-        // Aggiorna l'offset in base al movimento dell'auto
-        car.offset += updateCarOffset(car, oldSegment, playerSegment, playerW);
+    // Solo le auto vicine al giocatore vengono simulate, le altre avanzano in forma chiusa
+    traffic.updateWindow(position + playerZ);
 
-        // Aggiorna la posizione lungo il tracciato
-        car.z = Util::increase(car.z, dt * car.speed, trackLength);
+    auto stepStart = std::chrono::steady_clock::now();
+    windowTime += std::chrono::duration<double>(stepStart - windowStart).count();
 
-        // Calcola la percentuale rimanente per il rendering
-        car.percent = Util::percentRemaining(car.z, segmentLength);
+    int count = static_cast<int>(traffic.nearCount());
+    int blocks = (count + Traffic::BLOCK - 1) / Traffic::BLOCK;
+    float playerReach = Steering::reach(playerW);
 
-        // Trova il nuovo segmento dell'auto
-        Segment &newSegment = findSegment(car.z);
+    // Stato delle auto vicine in ordine di z per il kernel dello sterzo (seriale, lineare)
+    steering.build(traffic, carReach);
 
-        // Se l'auto è passata a un nuovo segmento, aggiorna i dati
-        if (&oldSegment != &newSegment) {
-            auto it = std::find(oldSegment.cars.begin(), oldSegment.cars.end(), car);
-            if (it != oldSegment.cars.end()) {
-                oldSegment.cars.erase(it);
-            }
-            newSegment.cars.push_back(car);
+    // Ogni auto legge solo lo stato del passo precedente e scrive nel buffer del passo
+    // successivo: i blocchi di auto sono indipendenti e si aggiornano in parallelo
+    trafficPool->parallelFor(blocks, [&](int block) {
+        int end = std::min(count, (block + 1) * Traffic::BLOCK);
+        for (int k = block * Traffic::BLOCK; k < end; k++) {
+            unsigned int car = traffic.nearCar(k);
+
+            // Aggiorna l'offset in base al movimento dell'auto
+            traffic.nextOffset[car] = traffic.offset[car] + steerCar(car, playerSegment, playerReach);
+
+            // Aggiorna la posizione lungo il tracciato
+            float z = Util::increase(traffic.z[car], dt * traffic.speed[car], trackLength);
+            traffic.nextZ[car] = z;
+
+            // Calcola la percentuale rimanente per il rendering e il nuovo segmento
+            traffic.nextPercent[car] = Util::percentRemaining(z, segmentLength);
+            traffic.nextSegment[car] = static_cast<unsigned int>(findSegment(z));
         }
+    });
 
-        // printf("Car %d: %f - %f - %f\n", car.index, car.z, car.offset, car.percent);
-    }
+    auto commitStart = std::chrono::steady_clock::now();
+    trafficTime += std::chrono::duration<double>(commitStart - stepStart).count();
+
+    // Sposta le auto tra i segmenti e riordina (seriale, lineare)
+    traffic.commit();
+    commitTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - commitStart).count();
 }
 
-float Game::updateCarOffset(Car &car, Segment &carSegment, Segment &playerSegment, float playerW) {
-    const int lookahead = 20;                 // Distanza di previsione
-    float carW = car.sprite.w * SPRITE_SCALE; // Larghezza dell'auto
+// Sterzo di un'auto. L'ostacolo più vicino che la blocca decide: le auto vicine nei
+// prossimi segmenti, cercate dal kernel sullo stato copiato in ordine di z, oppure il
+// giocatore (che a pari distanza viene prima delle auto). scalar sceglie il kernel
+// scalare (per il confronto di --bench-steering).
+float Game::steerCar(unsigned int car, size_t playerSegment, float playerReach, Steering::Kernel kernel) const {
+    const size_t lookahead = trafficLookahead; // Distanza di previsione (in segmenti)
+    size_t carSegment = traffic.segmentOf(car);
+    float carOffset = traffic.offset[car];
+    float carSpeed = traffic.speed[car];
 
     // Ottimizzazione: ignora le auto fuori dalla vista del giocatore
-    if ((carSegment.index - playerSegment.index) > drawDistance) {
+    if ((carSegment - playerSegment) > maxDrawDistance) {
         return 0.0f;
     }
 
-    for (int i = 1; i < lookahead; i++) {
-        const Segment &segment = segments[(carSegment.index + i) % segments.size()];
-
-        // Controllo collisione con il giocatore
-        if (&segment == &playerSegment && car.speed > speed &&
-            Util::overlap(playerX, playerW, car.offset, carW, 1.2f)) {
-            float dir = 0.0f;
-            if (playerX > 0.5f) {
-                dir = -1.0f;
-            } else if (playerX < -0.5f) {
-                dir = 1.0f;
-            } else {
-                dir = (car.offset > playerX) ? 1.0f : -1.0f;
-            }
-            return dir * (1.0f / i) * (car.speed - speed) / maxSpeed;
-        }
-
-        // Controllo collisione con altre auto
-        for (const Car &otherCar: segment.cars) {
-            float otherCarW = otherCar.sprite.w * SPRITE_SCALE;
-            if (car.speed > otherCar.speed && Util::overlap(car.offset, carW, otherCar.offset, otherCarW, 1.2f)) {
-                float dir = 0.0f;
-                if (otherCar.offset > 0.5f) {
-                    dir = -1.0f;
-                } else if (otherCar.offset < -0.5f) {
-                    dir = 1.0f;
-                } else {
-                    dir = (car.offset > otherCar.offset) ? 1.0f : -1.0f;
-                }
-                return dir * (1.0f / i) * (car.speed - otherCar.speed) / maxSpeed;
-            }
-        }
-    }
+    // Il giocatore conta come ostacolo se è nei prossimi segmenti: le auto più lontane non contano
+    size_t total = road.size();
+    size_t playerDistance = (playerSegment + total - carSegment) % total;
+    bool playerAhead = playerDistance > 0 && playerDistance < lookahead && carSpeed > speed &&
+                       Steering::overlap(playerX, playerReach, carOffset, carReach[traffic.type[car]]);
+    size_t limit = playerAhead ? playerDistance : lookahead;
+
+    // Controllo collisione con altre auto: tutte quelle nei prossimi segmenti (l'anello è
+    // ordinato per z, quindi la ricerca si ferma alla prima oltre il limite)
+    float result = 0.0f;
+    size_t count = traffic.nearCount() - 1;
+    bool blocked;
+    if (kernel == Steering::RING)
+        blocked = Steering::firstBlockingRing(traffic, carReach, car, count, limit, total, maxSpeed, result);
+    else if (kernel == Steering::SCALAR)
+        blocked = steering.firstBlockingScalar(traffic, car, count, limit, total, maxSpeed, result);
+    else
+        blocked = steering.firstBlocking(traffic, car, count, limit, total, maxSpeed, result);
+    if (blocked)
+        return result;
+
+    // Controllo collisione con il giocatore
+    if (playerAhead)
+        return Steering::steer(carOffset, carSpeed, playerX, speed, static_cast<float>(playerDistance), maxSpeed);
 
     // Se l'auto è fuori strada, correggi l'offset
-    if (car.offset < -0.9f) {
+    if (carOffset < -0.9f) {
         return 0.1f;
-    } else if (car.offset > 0.9f) {
+    } else if (carOffset > 0.9f) {
         return -0.1f;
     } else {
         return 0.0f;
@@ -546,43 +990,43 @@ void Game::resetSprites() {
     // Aggiungi sprite ai lati del tracciato
     addSprite(240, SPRITES::BILLBOARD07, -1.2f);
     addSprite(240, SPRITES::BILLBOARD06, 1.2f);
-    addSprite(segments.size() - 25, SPRITES::BILLBOARD07, -1.2f);
-    addSprite(segments.size() - 25, SPRITES::BILLBOARD06, 1.2f);
+    addSprite(road.size() - 25, SPRITES::BILLBOARD07, -1.2f);
+    addSprite(road.size() - 25, SPRITES::BILLBOARD06, 1.2f);
 
     // Aggiungi sprite a intervalli casuali
     for (int n = 10; n < 200; n += 4 + n / 100) {
-        addSprite(n, SPRITES::PALM_TREE, 0.5f + Util::randomFloat() * 0.5f);
-        addSprite(n, SPRITES::PALM_TREE, 1.0f + Util::randomFloat() * 2.0f);
+        addSprite(n, SPRITES::PALM_TREE, 0.5f + trackRandom.nextFloat() * 0.5f);
+        addSprite(n, SPRITES::PALM_TREE, 1.0f + trackRandom.nextFloat() * 2.0f);
     }
 
     // Aggiungi colonne e alberi
     for (int n = 250; n < 1000; n += 5) {
         addSprite(n, SPRITES::COLUMN, 1.1f);
-        addSprite(n + Util::randomInt(0, 5), SPRITES::TREE1, -1.0f - Util::randomFloat() * 2.0f);
-        addSprite(n + Util::randomInt(0, 5), SPRITES::TREE2, -1.0f - Util::randomFloat() * 2.0f);
+        addSprite(n + trackRandom.nextInt(0, 5), SPRITES::TREE1, -1.0f - trackRandom.nextFloat() * 2.0f);
+        addSprite(n + trackRandom.nextInt(0, 5), SPRITES::TREE2, -1.0f - trackRandom.nextFloat() * 2.0f);
     }
 
     // Aggiungi piante
-    for (unsigned int n = 200; n < segments.size(); n += 3) {
-        addSprite(n, Util::randomChoice(PLANTS), Util::randomChoice(choices) * (2.0f + Util::randomFloat() * 5.0f));
+    for (unsigned int n = 200; n < road.size(); n += 3) {
+        addSprite(n, trackRandom.choice(PLANTS), trackRandom.choice(choices) * (2.0f + trackRandom.nextFloat() * 5.0f));
     }
 
     // Aggiungi sprite complessi
-    for (int n = 1000; n < static_cast<int>(segments.size()) - 50; n += 100) {
-        float side = Util::randomChoice(choices);
-        addSprite(n + Util::randomInt(0, 50), Util::randomChoice(BILLBOARDS), -side);
+    for (int n = 1000; n < static_cast<int>(road.size()) - 50; n += 100) {
+        float side = trackRandom.choice(choices);
+        addSprite(n + trackRandom.nextInt(0, 50), trackRandom.choice(BILLBOARDS), -side);
 
         for (int i = 0; i < 20; ++i) {
-            Sprite sprite = Util::randomChoice(PLANTS);
-            float offset = side * (1.5f + Util::randomFloat());
-            addSprite(n + Util::randomInt(0, 50), sprite, offset);
+            Sprite sprite = trackRandom.choice(PLANTS);
+            float offset = side * (1.5f + trackRandom.nextFloat());
+            addSprite(n + trackRandom.nextInt(0, 50), sprite, offset);
         }
     }
 }
 
 void Game::resetRoad() {
     // Svuota l'elenco dei segmenti
-    segments.clear();
+    road.clear(segmentLength);
 
     // Aggiungi i vari tratti della strada
     addStraight(ROAD::LENGTH::SHORT);
@@ -607,35 +1051,51 @@ void Game::resetRoad() {
     // Resetta gli sprite e le auto
 
     resetSprites();
+    road.finalize();
     resetCars();
 
     // Configura il colore dei segmenti di partenza
-    size_t startIndex = findSegment(playerZ).index;
-    segments[startIndex + 2].color = START;
-    segments[startIndex + 3].color = START;
+    size_t startIndex = findSegment(playerZ);
+    road.setColor(startIndex + 2, PALETTE::START);
+    road.setColor(startIndex + 3, PALETTE::START);
 
     // Configura il colore dei segmenti di arrivo
     for (int n = 0; n < rumbleLength; n++) {
-        segments[segments.size() - 1 - n].color = FINISH;
+        road.setColor(road.size() - 1 - n, PALETTE::FINISH);
     }
 
     // Calcola la lunghezza totale del tracciato
-    trackLength = segments.size() * segmentLength;
+    trackLength = road.size() * segmentLength;
 }
 
 void Game::resetCars() {
-    cars.clear();
+    traffic.clear(road.size(), segmentLength);
+
+    carReach.clear();
+    for (const Sprite &sprite: CARS)
+        carReach.push_back(Steering::reach(sprite.w * SPRITE_SCALE));
+
+    // Finestra delle auto simulate: fino alla distanza di disegno più la previsione davanti
+    // al giocatore, la previsione dietro; le auto escono solo oltre un margine di 10 segmenti
+    traffic.setWindow(trafficLookahead * segmentLength, (maxDrawDistance + trafficLookahead) * segmentLength,
+                      10 * segmentLength, maxSpeed, step);
     float _speed;
 
+    const std::vector<float> sides = {-0.8f, 0.8f};
+
     for (int n = 0; n < totalCars; n++) {
+        // Ogni auto ha il proprio generatore: la stessa auto qualunque sia l'ordine di creazione
+        Random random = trafficRandom.fork(static_cast<uint64_t>(n));
+
         // Calcola l'offset casuale e scegli un lato casuale
-        float offset = Util::randomFloat() * Util::randomChoice(std::vector < float > {-0.8f, 0.8f});
+        float offset = random.nextFloat() * random.choice(sides);
 
         // Calcola la posizione z casuale
-        float z = Util::randomFloat() * static_cast<float>(segments.size()) * segmentLength;
+        float z = random.nextFloat() * static_cast<float>(road.size()) * segmentLength;
 
         // Seleziona uno sprite casuale
-        Sprite sprite = Util::randomChoice(CARS);
+        int type = random.nextInt(0, static_cast<int>(CARS.size()) - 1);
+        const Sprite &sprite = CARS[type];
 
         float c = 2.0f;
         if (sprite.h == SPRITES::SEMI.h &&
@@ -644,18 +1104,13 @@ void Game::resetCars() {
             sprite.w == SPRITES::SEMI.w)
             c = 4.0f;
         // Calcola la velocità dell'auto
-        _speed = maxSpeed / 4.0f + Util::randomFloat() * maxSpeed / c;
+        _speed = maxSpeed / 4.0f + random.nextFloat() * maxSpeed / c;
 
-        // Crea l'auto
-        Car car = {n, offset, z, sprite, _speed, 0.0f};
-
-        // Trova il segmento corrispondente e aggiungi l'auto
-        Segment &segment = findSegment(car.z);
-        segment.cars.push_back(car);
-
-        // Aggiungi l'auto alla lista globale
-        cars.push_back(car);
+        // Crea l'auto nel segmento corrispondente
+        traffic.add(z, offset, _speed, static_cast<unsigned char>(type));
     }
+
+    traffic.updateWindow(position + playerZ);
 }
 
 void Game::loadOptions(std::map <std::string, std::string> options) {
@@ -665,11 +1120,48 @@ void Game::loadOptions(std::map <std::string, std::string> options) {
     lanes = options.count("lanes") ? Util::toInt(options["lanes"], 3) : 3;
     roadWidth = options.count("roadWidth") ? Util::toFloat(options["roadWidth"], 2000.0f) : 2000.0f;
     cameraHeight = options.count("cameraHeight") ? Util::toFloat(options["cameraHeight"], 1000.0f) : 1000.0f;
-    drawDistance = options.count("drawDistance") ? Util::toInt(options["drawDistance"], 300) : 300;
+    // Almeno due segmenti: con meno il disegno non ha nulla da proiettare e il regolatore,
+    // arrivato a zero, non potrebbe più risalire
+    drawDistance = std::max(2, options.count("drawDistance") ? Util::toInt(options["drawDistance"], 300) : 300);
+    maxDrawDistance = drawDistance;
+    minDrawDistance = std::max(2, options.count("minDrawDistance") ? Util::toInt(options["minDrawDistance"], 50) : 50);
+    frameBudget = options.count("frameBudget") ? Util::toFloat(options["frameBudget"], 0.0f) : 0.0f;
+    telemetryFile = options.count("telemetry") ? options["telemetry"] : "";
+    maxRenderHeight = options.count("renderHeight") ? Util::toInt(options["renderHeight"], height) : height;
+    minRenderHeight = options.count("minRenderHeight") ? Util::toInt(options["minRenderHeight"], 240) : 240;
+    dynamicResolution = options.count("dynamicResolution") ? Util::toInt(options["dynamicResolution"], 0) != 0 : false;
     fogDensity = options.count("fogDensity") ? Util::toFloat(options["fogDensity"], 5.0f) : 5.0f;
     fieldOfView = options.count("fieldOfView") ? Util::toFloat(options["fieldOfView"], 100.0f) : 100.0f;
     segmentLength = options.count("segmentLength") ? Util::toFloat(options["segmentLength"], 200.0f) : 200.0f;
     rumbleLength = options.count("rumbleLength") ? Util::toInt(options["rumbleLength"], 3) : 3;
+    renderer = options.count("renderer") ? options["renderer"] : "raylib";
+    softwarePresent = options.count("softwarePresent") ? Util::toInt(options["softwarePresent"], 1) != 0 : true;
+    offscreen = renderer == "null" || (renderer == "software" && !softwarePresent);
+    offscreenFrames = options.count("offscreenFrames") ? Util::toInt(options["offscreenFrames"], 600) : 600;
+    dumpFrames = options.count("dumpFrames") ? options["dumpFrames"] : "";
+    dumpEvery = options.count("dumpEvery") ? Util::toInt(options["dumpEvery"], 60) : 60;
+    softwareThreads = options.count("softwareThreads") ? Util::toInt(options["softwareThreads"], 0) : 0;
+    scanlineRoad = options.count("roadMode") ? options["roadMode"] == "scanline" : false;
+    lodPixels = options.count("lodPixels") ? Util::toFloat(options["lodPixels"], 0.0f) : 0.0f;
+    totalCars = options.count("totalCars") ? Util::toInt(options["totalCars"], 200) : 200;
+    headless = options.count("headless") ? Util::toInt(options["headless"], 0) != 0 : false;
+    headlessSeconds = options.count("headlessSeconds") ? Util::toFloat(options["headlessSeconds"], 600.0f) : 600.0f;
+    steeringBenchmark = options.count("benchSteering") ? Util::toInt(options["benchSteering"], 0) != 0 : false;
+    headlessLaps = options.count("headlessLaps") ? Util::toInt(options["headlessLaps"], 0) : 0;
+    recordFile = options.count("record") ? options["record"] : "";
+    // Senza seme ogni partita è diversa
+    seed = options.count("seed") ? std::strtoull(options["seed"].c_str(), nullptr, 10)
+                                 : static_cast<uint64_t>(std::time(nullptr));
+
+    // Un flusso di numeri casuali per ogni sottosistema, tutti derivati dallo stesso seme
+    trackRandom.seed(seed, Random::TRACK);
+    trafficRandom.seed(seed, Random::TRAFFIC);
+    jitterRandom.seed(seed, Random::JITTER);
+    printf("Seed: %llu\n", static_cast<unsigned long long>(seed));
+    trafficThreads = options.count("trafficThreads") ? Util::toInt(options["trafficThreads"], 0) : 0;
+    targetFPS = options.count("targetFPS") ? Util::toInt(options["targetFPS"], 60) : 60;
+    vsync = options.count("vsync") ? Util::toInt(options["vsync"], 0) != 0 : false;
+    maxSubSteps = options.count("maxSubSteps") ? Util::toInt(options["maxSubSteps"], 5) : 5;
 
     // Calcoli aggiuntivi
     cameraDepth = 1.0f / std::tan((fieldOfView / 2.0f) * (M_PI / 180.0f));
@@ -677,36 +1169,20 @@ void Game::loadOptions(std::map <std::string, std::string> options) {
     resolution = static_cast<float>(height) / 480.0f;
 
     // Ricostruisci la strada se necessario
-    if (segments.empty() || options.count("segmentLength") || options.count("rumbleLength")) {
+    if (road.empty() || options.count("segmentLength") || options.count("rumbleLength")) {
         resetRoad();
     }
 }
 
 /* Segments functions */
 void Game::addSegment(float curve, float y) {
-    size_t n = segments.size();
-    Segment segment;
-
-    segment.index = n;
-
-    // Definizione del primo punto
-    segment.p1.world.y = lastY();
-    segment.p1.world.z = n * segmentLength;
-
-    // Definizione del secondo punto
-    segment.p2.world.y = y;
-    segment.p2.world.z = (n + 1) * segmentLength;
-
-    segment.curve = curve;
+    size_t n = road.size();
 
     // Alterna colori per il rumble strip
-    segment.color = ((n / rumbleLength) % 2 == 0) ? DARK : LIGHT;
-
-    // Aggiungi il segmento al vettore
-    segments.push_back(segment);
+    road.add(curve, y, ((n / rumbleLength) % 2 == 0) ? PALETTE::DARK : PALETTE::LIGHT);
 }
 
-Segment &Game::findSegment(float z) {
-    int index = static_cast<int>(std::floor(z / segmentLength)) % segments.size();
-    return segments[index];
+size_t Game::findSegment(float z) {
+    int index = static_cast<int>(std::floor(z / segmentLength)) % road.size();
+    return index;
 }
@@ -6,25 +6,47 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <chrono>
 
 #include "common.hpp"
 #include "util.hpp"
 
 #include "drawing.hpp"
+#include "raylibdrawing.hpp"
+#include "softwaredrawing.hpp"
+#include "nulldrawing.hpp"
+#include "projection.hpp"
+#include "road.hpp"
+#include "traffic.hpp"
+#include "steering.hpp"
+#include "threadpool.hpp"
+#include "random.hpp"
+#include "governor.hpp"
+#include "fog.hpp"
+#include "hud.hpp"
+#include "timestep.hpp"
 #include "audio.hpp"
+#include "replay.hpp"
 
 #include <nlohmann/json.hpp>
 
 class Game
 {
 public:
-    void init();
+    void init(const std::map<std::string, std::string> &overrides = {});
     void destroy();
 
     void update();
-    void updateHUD(std::string key, std::string value);
+    void advance(double elapsed);
     void frame();
     void pollKeys();
+    int runHeadless();
+    int runOffscreen();
+    int benchSteering();
+    uint64_t stateHash() const;
 
     void loadOptions(std::map<std::string, std::string> options);
 
@@ -33,12 +55,16 @@ public:
 
     int getFPS() { return fps; }
     bool isPaused() { return paused; }
+    bool isHeadless() { return headless; }
+    bool isOffscreen() { return offscreen; }
     void togglePause();
 
 private:
-    Font fontTtf;
     Audio audio;
-    Drawing drawing;
+    std::unique_ptr<Drawing> drawing;       // Backend di disegno (raylib, software o null)
+    Projection projection;                  // Buffer di proiezione dei confini dei segmenti
+    RoadLines roadLines;                    // Tabella per riga del motore della strada a linee
+    FogTable fogTable;                      // Fattore della nebbia per distanza in segmenti
     float fastestLapTime = 0.0f; // Miglior tempo
 
     // Stato della tastiera
@@ -47,8 +73,24 @@ private:
     bool keyFaster = false;
     bool keySlower = false;
 
-    const int fps = 60;                     // Frame per secondo
-    const float step = 1.0f / fps;          // Durata di ogni frame (in secondi)
+    // Registrazione e riproduzione degli ingressi per passo
+    Replay replay;
+    std::string recordFile;                 // File in cui salvare la registrazione ("" = non registrare)
+    bool replaying = false;                 // Gli ingressi arrivano dal replay invece che dalla tastiera
+
+    const int fps = 60;                     // Passi di simulazione al secondo
+    const float step = 1.0f / fps;          // Durata di ogni passo (in secondi)
+    int targetFPS = 60;                     // Limite dei frame disegnati (0 = nessun limite)
+    bool vsync = false;                     // Sincronizza i frame con il monitor
+    int maxSubSteps = 5;                    // Passi massimi per frame prima di scartare il tempo
+    FixedTimestep timestep;                 // Accumulatore del tempo reale
+
+    // Stato del passo precedente, per interpolare il disegno tra gli ultimi due passi
+    float previousPosition = 0.0f;
+    float previousPlayerX = 0.0f;
+    float previousSkyOffset = 0.0f;
+    float previousHillOffset = 0.0f;
+    float previousTreeOffset = 0.0f;
 
     const float centrifugal = 0.3f;         // Moltiplicatore di forza centrifuga
     const float skySpeed = 0.001f;          // Velocità di scorrimento dello sfondo (cielo)
@@ -58,13 +100,20 @@ private:
     float skyOffset = 0.0f;                 // Offset attuale dello sfondo (cielo)
     float hillOffset = 0.0f;                // Offset attuale dello sfondo (colline)
     float treeOffset = 0.0f;                // Offset attuale dello sfondo (alberi)
-    std::vector<Segment> segments;          // Array di segmenti stradali
-    std::vector<Car> cars;                  // Array di auto sulla strada
+    Road road;                              // Geometria statica della strada
+    Traffic traffic;                        // Auto sulla strada, collegate al loro segmento
+    uint64_t seed = 0;                      // Seme dei generatori casuali
+    Random trackRandom;                     // Decorazioni del tracciato
+    Random trafficRandom;                   // Auto del traffico
+    Random jitterRandom;                    // Effetti visivi
+    int trafficThreads = 0;                 // Thread per l'aggiornamento del traffico (0 = uno per core)
+    const size_t trafficLookahead = 20;     // Segmenti davanti in cui le auto cercano ostacoli
+    std::unique_ptr<ThreadPool> trafficPool;
+    Steering steering;                      // Stato delle auto vicine in ordine di z per lo sterzo
+    std::vector<float> carReach;            // Semi larghezza con margine di ogni tipo di auto
     void *stats = nullptr;                  // Placeholder per un contatore FPS (es. Mr. Doob's)
     void *canvas = nullptr;                 // Placeholder per il canvas
     void *ctx = nullptr;                    // Placeholder per il contesto grafico
-    Texture2D background;                   // Immagine di sfondo (da caricare)
-    Texture2D sprites;                      // Spritesheet (da caricare)
     float resolution = 0.0f;                // Fattore di scaling per risoluzione indipendente
     float roadWidth = 2000.0f;              // Larghezza della strada
     float segmentLength = 200.0f;           // Lunghezza di un segmento
@@ -74,7 +123,25 @@ private:
     float fieldOfView = 100.0f;             // Angolo del campo visivo (in gradi)
     float cameraHeight = 1000.0f;           // Altezza della telecamera
     float cameraDepth = 0.0f;               // Distanza Z della telecamera (calcolata)
-    size_t drawDistance = 300;              // Numero di segmenti da disegnare
+    size_t drawDistance = 300;              // Numero di segmenti da disegnare (deciso dal regolatore se attivo)
+    size_t maxDrawDistance = 300;           // Distanza di disegno configurata
+    size_t minDrawDistance = 50;            // Distanza minima concessa al regolatore
+    float frameBudget = 0.0f;               // Tempo CPU per frame in ms da rispettare (0 = regolatore spento)
+    Governor drawGovernor;                  // Regolatore della distanza di disegno
+
+    double updateTime = 0.0;                // Tempo CPU degli update dall'ultimo frame (secondi)
+    double windowTime = 0.0;                // Tempi totali delle fasi del traffico (secondi, per la modalità headless)
+    double trafficTime = 0.0;
+    double commitTime = 0.0;
+
+    bool headless = false;                  // Solo simulazione, senza finestra, grafica e audio
+    float headlessSeconds = 600.0f;         // Secondi simulati in modalità headless
+    int headlessLaps = 0;                   // Giri da completare in modalità headless (0 = usa headlessSeconds)
+    int laps = 0;                           // Giri completati
+    bool steeringBenchmark = false;         // Misura lo sterzo del traffico invece di simulare
+    unsigned long long frameCount = 0;      // Frame disegnati
+    std::string telemetryFile;              // File CSV con i tempi e le decisioni di ogni frame
+    FILE *telemetry = nullptr;
     float playerX = 0.0f;                   // Offset X del giocatore (-1 a 1)
     float playerZ = 0.0f;                   // Distanza Z relativa del giocatore (calcolata)
     float fogDensity = 5.0f;                // Densità della nebbia
@@ -91,15 +158,39 @@ private:
     float lastLapTime = 0.0f;               // Ultimo tempo del giro
     int width = 1024;                       // Larghezza logica del canvas
     int height = 768;                       // Altezza logica del canvas
+    int renderWidth = 1024;                 // Larghezza della scena (risoluzione interna)
+    int renderHeight = 768;                 // Altezza della scena (risoluzione interna)
+    int maxRenderHeight = 768;              // Altezza interna configurata (renderHeight)
+    int minRenderHeight = 240;              // Altezza minima con la risoluzione dinamica
+    bool dynamicResolution = false;         // Risoluzione interna regolata dal tempo di frame
+    Governor resolutionGovernor;            // Regolatore della risoluzione interna
+    Hud hud;                                // Campi dell'HUD con i glifi in cache
 
     bool paused = false;                    // Game is paused
+    bool showStats = false;                 // Mostra le statistiche di rendering (TAB)
+
+    std::string renderer = "raylib";        // Backend di disegno: "raylib", "software" o "null"
+    bool softwarePresent = true;            // Il backend software mostra il frame nella finestra
+    bool offscreen = false;                 // Backend nullo o software senza present: niente finestra, GL e audio
+    int offscreenFrames = 600;              // Frame disegnati senza finestra prima di uscire
+    std::string dumpFrames;                 // Prefisso dei file per salvare i frame del backend software
+    int dumpEvery = 60;                     // Salva un frame ogni dumpEvery
+    int softwareThreads = 0;                // Thread del backend software (0 = uno per core)
+    bool scanlineRoad = false;              // Strada disegnata per righe invece che per segmenti
+    float lodPixels = 0.0f;                 // Altezza sotto la quale i segmenti vengono accorpati (0 = nessun LOD)
+    int visibleSprites = 0;                 // Sprite accodati nell'ultimo frame
+    int culledSprites = 0;                  // Sprite scartati dal culling nell'ultimo frame
 
-    void loadImages();
     void saveScore();
     void loadScore();
     float lastY();
 
     void renderHUD();
+    void renderStats();
+    void governFrame(double frameTime);
+    void setRenderHeight(int _renderHeight);
+    void autopilot();
+    void drawRoadSegment(size_t from, size_t to, unsigned char color, float clipY);
 
     void addSprite(size_t n, Sprite sprite, float offset);
     void addRoad(int enter, int hold, int leave, float curve, float y);
@@ -115,11 +206,12 @@ private:
     void resetRoad();
     void resetCars();
 
-    void updateCars(float dt, Segment &playerSegment, float playerW);
-    float updateCarOffset(Car &car, Segment &carSegment, Segment &playerSegment, float playerW);
+    void updateCars(float dt, size_t playerSegment, float playerW);
+    float steerCar(unsigned int car, size_t playerSegment, float playerReach,
+                   Steering::Kernel kernel = Steering::VECTOR) const;
 
     void addSegment(float curve, float y);
-    Segment &findSegment(float z);
+    size_t findSegment(float z);
 
     std::vector<std::string> tracks = { "resources/music/track1.mp3", "resources/music/track2.mp3", "resources/music/track3.mp3" };
     unsigned int currentTrack = 0;
@@ -0,0 +1,54 @@
+#include "governor.hpp"
+
+#include <algorithm>
+
+void Governor::setup(float _budget, float _minValue, float _maxValue) {
+    budget = _budget;
+    minValue = std::min(_minValue, _maxValue);
+    maxValue = _maxValue;
+    current = maxValue;
+    averageTime = 0.0f;
+    cooldown = 0;
+    warmup = settleFrames;
+    primed = false;
+    lastDecision = HOLD;
+}
+
+float Governor::update(float frameTime, bool allowDown, bool allowUp) {
+    lastDecision = HOLD;
+    if (!enabled())
+        return current;
+
+    // I primi frame sono freddi (caricamento delle texture, prime allocazioni,
+    // avvio dei thread): non entrano nella media
+    if (warmup > 0) {
+        warmup--;
+        return current;
+    }
+
+    if (!primed) {
+        averageTime = frameTime;
+        primed = true;
+    } else {
+        averageTime += smoothing * (frameTime - averageTime);
+    }
+
+    if (cooldown > 0) {
+        cooldown--;
+        return current;
+    }
+
+    if (averageTime > budget && current > minValue && allowDown) {
+        // Riduce in proporzione allo sforamento
+        float factor = std::max(maxDrop, budget / averageTime);
+        current = std::max(minValue, current * factor);
+        lastDecision = DOWN;
+        cooldown = settleFrames;
+    } else if (averageTime < budget * raiseBelow && current < maxValue && allowUp) {
+        current = std::min(maxValue, current * raiseStep);
+        lastDecision = UP;
+        cooldown = settleFrames;
+    }
+
+    return current;
+}
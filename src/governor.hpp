@@ -0,0 +1,49 @@
+#ifndef __GOVERNOR_HPP__
+#define __GOVERNOR_HPP__
+
+// Regolatore di qualità guidato dal tempo di frame misurato.
+// Tiene una media mobile del tempo di frame e sposta un valore (per esempio la
+// distanza di disegno) tra un minimo e un massimo per restare nel budget:
+// scende subito in proporzione allo sforamento, sale piano solo quando c'è margine.
+// Tra le due soglie il valore non cambia (isteresi) e dopo ogni modifica aspetta
+// qualche frame prima di decidere di nuovo, così la media ha il tempo di assestarsi.
+class Governor
+{
+public:
+    enum Decision { DOWN = -1, HOLD = 0, UP = 1 };
+
+    // budget: tempo di frame desiderato in secondi (0 = regolatore spento)
+    void setup(float _budget, float _minValue, float _maxValue);
+    bool enabled() const { return budget > 0.0f; }
+
+    // Registra il tempo dell'ultimo frame (in secondi) e ritorna il nuovo valore;
+    // allowDown e allowUp permettono di bloccare una direzione (la media si aggiorna comunque)
+    float update(float frameTime, bool allowDown = true, bool allowUp = true);
+
+    float value() const { return current; }
+    bool atMin() const { return current <= minValue; }
+    bool atMax() const { return current >= maxValue; }
+    float average() const { return averageTime; }
+    float getBudget() const { return budget; }
+    Decision decision() const { return lastDecision; }
+
+    // Parametri di regolazione
+    float smoothing = 0.1f;         // Peso dell'ultimo frame nella media mobile
+    float raiseBelow = 0.8f;        // Sale solo se la media è sotto questa frazione del budget
+    float raiseStep = 1.05f;        // Fattore di crescita
+    float maxDrop = 0.5f;           // Riduzione massima in un solo passo
+    int settleFrames = 10;          // Frame di attesa dopo una modifica (e frame ignorati all'avvio)
+
+private:
+    float budget = 0.0f;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    float current = 0.0f;
+    float averageTime = 0.0f;
+    int cooldown = 0;
+    int warmup = 0;
+    bool primed = false;
+    Decision lastDecision = HOLD;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "hud.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+static const Color BOX_COLOR = Color{0xFF, 0xFF, 0xFF, 127};
+
+// Scrive il tempo come Util::formatTime ("M.SS.T" oppure "S.T") a partire dai decimi
+static int FormatTenths(char *buffer, size_t size, int tenths) {
+    int minutes = tenths / 600;
+    int seconds = (tenths / 10) % 60;
+
+    if (minutes > 0)
+        return snprintf(buffer, size, "%d.%02d.%d", minutes, seconds, tenths % 10);
+    return snprintf(buffer, size, "%d.%d", seconds, tenths % 10);
+}
+
+void Hud::set(Field field, int value) {
+    Entry &entry = entries[field];
+    if (entry.value != value) {
+        entry.value = value;
+        entry.dirty = true;
+    }
+}
+
+void Hud::setNumber(Field field, int value) {
+    set(field, value);
+}
+
+void Hud::setTime(Field field, float seconds) {
+    set(field, static_cast<int>(std::floor(seconds * 10.0f)));
+}
+
+void Hud::format(Field field) {
+    Entry &entry = entries[field];
+    char value[16];
+
+    switch (field) {
+        case SPEED:
+            snprintf(entry.text, sizeof(entry.text), "%d Mph", entry.value);
+            break;
+        case CURRENT_LAP:
+            FormatTenths(value, sizeof(value), entry.value);
+            snprintf(entry.text, sizeof(entry.text), "Time: %s", value);
+            break;
+        case FASTEST_LAP:
+            FormatTenths(value, sizeof(value), entry.value);
+            snprintf(entry.text, sizeof(entry.text), "Fastest Lap: %s", value);
+            break;
+        default:
+            break;
+    }
+}
+
+void Hud::render(Drawing &drawing, int width) {
+    // Draw HUD Rectangle
+    drawing.DrawRectangle(0, 0, width, 60, Color{0xFF, 0x00, 0x00, 127});
+    drawing.DrawRectangleLines(0, 0, width, 60, BLACK);
+
+    // Time
+    drawing.DrawRectangle(10, 10, 160, 40, BOX_COLOR);
+    drawing.DrawRectangleLines(10, 10, 160, 40, BLACK);
+
+    // Speed
+    drawing.DrawRectangle(width - 160, 10, 160, 40, BOX_COLOR);
+    drawing.DrawRectangleLines(width - 160, 10, 160, 40, BLACK);
+
+    // Current Lap
+    drawing.DrawRectangle(width / 3 - 150, 10, 250, 40, BOX_COLOR);
+    drawing.DrawRectangleLines(width / 3 - 150, 10, 250, 40, BLACK);
+
+    // Fastest Lap
+    drawing.DrawRectangle((width / 2) + 70, 10, 250, 40, BOX_COLOR);
+    drawing.DrawRectangleLines((width / 2) + 70, 10, 250, 40, BLACK);
+
+    // Le posizioni dipendono dalla larghezza: se cambia vanno reimpaginati tutti i campi
+    bool relayout = width != layoutWidth;
+    layoutWidth = width;
+
+    const float positions[FIELD_COUNT] = {width - 150.0f, 20.0f, width / 3.0f - 140.0f};
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        Entry &entry = entries[i];
+        if (entry.value < 0)
+            continue;
+
+        if (entry.dirty || relayout) {
+            format(static_cast<Field>(i));
+            drawing.LayoutText(entry.text, positions[i], 20.0f, entry.run);
+            entry.dirty = false;
+        }
+
+        drawing.DrawGlyphs(entry.run, BLACK);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef __HUD_HPP__
+#define __HUD_HPP__
+
+#include "raylib.h"
+#include "drawing.hpp"
+
+// HUD con i campi indicizzati da un enum. Il testo di ogni campo viene formattato
+// in un buffer fisso senza allocazioni e i glifi impaginati restano in cache finché
+// il valore mostrato non cambia (i tempi hanno la risoluzione del decimo di secondo).
+class Hud
+{
+public:
+    enum Field {
+        SPEED,
+        CURRENT_LAP,
+        FASTEST_LAP,
+        FIELD_COUNT
+    };
+
+    void setNumber(Field field, int value);
+    void setTime(Field field, float seconds);
+
+    // Disegna i riquadri e i testi, reimpaginando solo i campi cambiati
+    void render(Drawing &drawing, int width);
+
+private:
+    struct Entry {
+        int value = -1;             // Valore mostrato (numero o decimi di secondo)
+        bool dirty = true;
+        char text[32] = {};
+        GlyphRun run;
+    };
+
+    void set(Field field, int value);
+    void format(Field field);
+
+    Entry entries[FIELD_COUNT];
+    int layoutWidth = -1;           // Larghezza dello schermo dell'ultima impaginazione
+};
+
+#endif
@@ -5,23 +5,61 @@
 
 #include "game.hpp"
 
-int main() {
-    srand(static_cast<unsigned>(time(0))); // Inizializza il generatore casuale
+int main(int argc, char *argv[]) {
+    // Opzioni della riga di comando (hanno la precedenza su options.json)
+    std::map<std::string, std::string> options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc)
+            options["seed"] = argv[++i];
+        else if (arg == "--headless")
+            options["headless"] = "1";
+        else if (arg == "--seconds" && i + 1 < argc)
+            options["headlessSeconds"] = argv[++i];
+        else if (arg == "--laps" && i + 1 < argc)
+            options["headlessLaps"] = argv[++i];
+        else if (arg == "--bench-steering") {
+            options["headless"] = "1";
+            options["benchSteering"] = "1";
+        } else if (arg == "--record" && i + 1 < argc)
+            options["record"] = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            options["replay"] = argv[++i];
+        else if (arg == "--frames" && i + 1 < argc)
+            options["offscreenFrames"] = argv[++i];
+    }
 
     Game game;
 
-    game.init();
+    game.init(options);
+
+    // Solo simulazione: nessuna finestra da chiudere
+    if (game.isHeadless()) {
+        int result = game.runHeadless();
+        game.destroy();
+        return result;
+    }
+
+    // Backend nullo o software senza finestra: un numero fisso di frame, senza audio
+    if (game.isOffscreen()) {
+        int result = game.runOffscreen();
+        game.destroy();
+        return result;
+    }
 
+    double previousTime = GetTime();
     while (!WindowShouldClose()) {
+        double now = GetTime();
         game.pollKeys();
 
         if (!game.isPaused()) {
             game.updateAudioTrack();
 
-            game.update(); // Chiama la funzione update per ogni intervallo di tempo fisso
+            game.advance(now - previousTime); // Esegue zero o più update a passo fisso
         }
+        previousTime = now;
 
-        game.frame();
+        game.frame(); // Disegna interpolando tra gli ultimi due passi
     }
 
     game.unloadAudioTrack(); // Unload music stream buffers from RAM
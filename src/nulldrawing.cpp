@@ -0,0 +1,57 @@
+#include "nulldrawing.hpp"
+
+#include <cstdio>
+
+void NullDrawing::UnloadResources() {
+    // Riepilogo dei conteggi medi per frame
+    if (frames > 0) {
+        double n = static_cast<double>(frames);
+        printf("Null renderer: %lld frames, %.3f ms/frame\n", frames, 1000.0 * totalFrameTime / n);
+        printf("  quads/frame: %.1f, sprites/frame: %.1f, backgrounds/frame: %.1f\n",
+               totalQuads / n, totalSprites / n, totalBackgrounds / n);
+        printf("  rectangles/frame: %.1f, text runs/frame: %.1f\n", totalRectangles / n, totalTextRuns / n);
+    }
+}
+
+void NullDrawing::BeginFrame(int _width, int _height) {
+    frameStart = std::chrono::steady_clock::now();
+}
+
+void NullDrawing::EndFrame() {
+    totalFrameTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+    frames++;
+}
+
+void NullDrawing::FlushRoad() {
+    roadQuads = static_cast<int>(roadList.size());
+    roadDrawCalls = 0;
+    totalQuads += roadQuads;
+    roadList.clear();
+}
+
+void NullDrawing::DrawBackground(int _width, int _height, int layer, float rotation, float offset) {
+    totalBackgrounds++;
+}
+
+void NullDrawing::FlushSprites() {
+    spriteCount = static_cast<int>(spriteList.size());
+    spriteDrawCalls = 0;
+    totalSprites += spriteCount;
+    spriteList.clear();
+}
+
+void NullDrawing::DrawRectangle(int x, int y, int _width, int _height, Color color) {
+    totalRectangles++;
+}
+
+void NullDrawing::DrawRectangleLines(int x, int y, int _width, int _height, Color color) {
+    totalRectangles++;
+}
+
+void NullDrawing::DrawText(const char *text, float x, float y, Color color) {
+    totalTextRuns++;
+}
+
+void NullDrawing::DrawGlyphs(const GlyphRun &run, Color color) {
+    totalTextRuns++;
+}
@@ -0,0 +1,42 @@
+#ifndef __NULLDRAWING_HPP__
+#define __NULLDRAWING_HPP__
+
+#include <chrono>
+
+#include "drawing.hpp"
+
+// Backend di disegno nullo: non disegna nulla, conta soltanto quello che riceve.
+// Serve a misurare il costo CPU di proiezione, culling e costruzione delle liste
+// di disegno senza l'overhead del driver grafico.
+class NullDrawing : public Drawing {
+    public:
+        void LoadResources() override {}
+        void UnloadResources() override;
+        void BeginFrame(int _width, int _height) override;
+        void BeginOverlay(int _width, int _height) override {}
+        void EndFrame() override;
+
+        void FlushRoad() override;
+        void DrawBackground(int _width, int _height, int layer, float rotation, float offset) override;
+        void FlushSprites() override;
+
+        void DrawRectangle(int x, int y, int _width, int _height, Color color) override;
+        void DrawRectangleLines(int x, int y, int _width, int _height, Color color) override;
+        void DrawText(const char *text, float x, float y, Color color) override;
+        void DrawFPS(int x, int y) override {}
+        void DrawGlyphs(const GlyphRun &run, Color color) override;
+
+    private:
+        // Totali dall'avvio
+        long long frames = 0;
+        long long totalQuads = 0;
+        long long totalSprites = 0;
+        long long totalBackgrounds = 0;
+        long long totalRectangles = 0;
+        long long totalTextRuns = 0;
+
+        std::chrono::steady_clock::time_point frameStart;
+        double totalFrameTime = 0.0;    // Tempo CPU tra BeginFrame e EndFrame (secondi)
+};
+
+#endif
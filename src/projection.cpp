@@ -0,0 +1,42 @@
+#include "projection.hpp"
+
+#include <cmath>
+
+void Projection::resize(size_t points) {
+    count = points;
+    if (cameraX.size() < points) {
+        cameraX.resize(points);
+        cameraY.resize(points);
+        cameraZ.resize(points);
+        screenX.resize(points);
+        screenY.resize(points);
+        screenW.resize(points);
+        screenScale.resize(points);
+        looped.resize(points);
+        clip.resize(points);
+    }
+}
+
+// Proiezione prospettica di tutti i punti del buffer.
+// Il ciclo non ha dipendenze tra iterazioni e lavora su array contigui, quindi
+// il compilatore può vettorializzarlo.
+void Projection::project(float cameraDepth, float width, float height, float roadWidth) {
+    const float *cx = cameraX.data();
+    const float *cy = cameraY.data();
+    const float *cz = cameraZ.data();
+    float *sx = screenX.data();
+    float *sy = screenY.data();
+    float *sw = screenW.data();
+    float *ss = screenScale.data();
+
+    const float halfWidth = width / 2;
+    const float halfHeight = height / 2;
+
+    for (size_t i = 0; i < count; i++) {
+        float scale = cameraDepth / cz[i];
+        ss[i] = scale;
+        sx[i] = std::round(halfWidth + (scale * cx[i] * width / 2));
+        sy[i] = std::round(halfHeight - (scale * cy[i] * height / 2));
+        sw[i] = std::round(scale * roadWidth * width / 2);
+    }
+}
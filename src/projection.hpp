@@ -0,0 +1,40 @@
+#ifndef __PROJECTION_HPP__
+#define __PROJECTION_HPP__
+
+#include <vector>
+#include <cstddef>
+
+// Buffer di proiezione della strada (struct-of-arrays).
+// Ogni confine di segmento viene proiettato una sola volta: il punto k è p1 del
+// segmento k e p2 del segmento k - 1. Contiene anche i dati per segmento
+// calcolati ad ogni frame (drawDistance valori).
+class Projection
+{
+public:
+    // Ridimensiona il buffer per contenere il numero di punti richiesto
+    void resize(size_t points);
+    size_t size() const { return count; }
+
+    // Proietta tutti i punti a partire dalle coordinate camera già impostate
+    void project(float cameraDepth, float width, float height, float roadWidth);
+
+    // Coordinate camera (da riempire prima di project)
+    std::vector<float> cameraX;
+    std::vector<float> cameraY;
+    std::vector<float> cameraZ;
+
+    // Coordinate schermo (risultato di project)
+    std::vector<float> screenX;
+    std::vector<float> screenY;
+    std::vector<float> screenW;
+    std::vector<float> screenScale;
+
+    // Dati per segmento
+    std::vector<unsigned char> looped;  // Numero di giri oltre la fine della strada
+    std::vector<float> clip;
+
+private:
+    size_t count = 0;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "random.hpp"
+
+// SplitMix64: espande il seme nello stato del generatore
+static uint64_t SplitMix64(uint64_t &x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t Rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+void Random::seed(uint64_t _seed, uint64_t _stream) {
+    seedValue = _seed;
+    streamValue = _stream;
+
+    uint64_t x = _seed ^ (_stream * 0xD1B54A32D192ED03ull);
+    uint64_t a = SplitMix64(x);
+    uint64_t b = SplitMix64(x);
+    state[0] = static_cast<uint32_t>(a);
+    state[1] = static_cast<uint32_t>(a >> 32);
+    state[2] = static_cast<uint32_t>(b);
+    state[3] = static_cast<uint32_t>(b >> 32);
+
+    // Lo stato tutto a zero non è valido
+    if ((state[0] | state[1] | state[2] | state[3]) == 0)
+        state[0] = 1;
+}
+
+Random Random::fork(uint64_t index) const {
+    uint64_t x = seedValue ^ (streamValue * 0xA0761D6478BD642Full);
+    return Random(SplitMix64(x), index);
+}
+
+uint32_t Random::next() {
+    uint32_t result = Rotl(state[1] * 5, 7) * 9;
+    uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = Rotl(state[3], 11);
+
+    return result;
+}
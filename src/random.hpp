@@ -0,0 +1,53 @@
+#ifndef __RANDOM_HPP__
+#define __RANDOM_HPP__
+
+#include <cstdint>
+#include <vector>
+
+// Generatore pseudo casuale xoshiro128** (stato di 128 bit, solo operazioni a 32 bit).
+// Ogni sottosistema usa il proprio flusso, derivato dal seme e dal numero del flusso,
+// così cambiare il consumo di uno non sposta gli altri. fork(index) ricava un
+// generatore indipendente per ogni elemento (un'auto, un blocco di lavoro): gli
+// elementi generati in parallelo non dipendono dal numero di thread.
+class Random
+{
+public:
+    // Flussi dei sottosistemi
+    enum Stream {
+        TRACK,          // Decorazioni del tracciato
+        TRAFFIC,        // Auto del traffico
+        JITTER,         // Effetti visivi (sobbalzi del giocatore)
+        STREAM_COUNT
+    };
+
+    Random(uint64_t _seed = 0, uint64_t _stream = 0) { seed(_seed, _stream); }
+
+    void seed(uint64_t _seed, uint64_t _stream);
+
+    // Generatore indipendente per l'elemento index di questo flusso
+    Random fork(uint64_t index) const;
+
+    uint32_t next();
+
+    // Float in [0, 1)
+    float nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    // Intero tra min e max compresi
+    int nextInt(int min, int max) {
+        uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min + 1);
+        return min + static_cast<int>((static_cast<uint64_t>(next()) * range) >> 32);
+    }
+
+    // Elemento casuale di un array
+    template <typename T>
+    const T &choice(const std::vector<T> &options) {
+        return options[nextInt(0, static_cast<int>(options.size()) - 1)];
+    }
+
+private:
+    uint64_t seedValue = 0;
+    uint64_t streamValue = 0;
+    uint32_t state[4] = {};
+};
+
+#endif
@@ -0,0 +1,231 @@
+#include "raylib.h"
+#include "rlgl.h"
+
+#include "common.hpp"
+#include "raylibdrawing.hpp"
+
+#include <algorithm>
+
+// Funzione per caricare le risorse (sfondo, spritesheet e font)
+void RaylibDrawing::LoadResources() {
+    Image image = LoadImage("resources/images/background.png"); // Loaded in CPU memory (RAM)
+
+    // Gli strati (1280x480) non sono potenze di due: OpenGL 1.1 (MiniGL su OS4) e
+    // GLES2 non ripetono queste texture, lì lo strato si disegna in due rettangoli
+    int version = rlGetVersion();
+    repeatLayers = version != RL_OPENGL_11 && version != RL_OPENGL_ES_20;
+
+    // Ogni strato in una texture propria, così può ripetersi con il wrap della GPU
+    for (int i = 0; i < BACKGROUND::LAYER_COUNT; i++) {
+        const Sprite &layer = BACKGROUND::LAYERS[i];
+        Image layerImage = ImageFromImage(image, Rectangle{static_cast<float>(layer.x), static_cast<float>(layer.y),
+                                                           static_cast<float>(layer.w), static_cast<float>(layer.h)});
+        layers[i] = LoadTextureFromImage(layerImage);           // Image converted to texture, GPU memory (VRAM)
+        if (repeatLayers)
+            SetTextureWrap(layers[i], TEXTURE_WRAP_REPEAT);
+        UnloadImage(layerImage);
+    }
+    UnloadImage(image);
+
+    image = LoadImage("resources/images/sprites.png");
+    sprites = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    font = LoadFontEx("resources/font/Retroica.ttf", 24, 0, 250);
+}
+
+// Funzione per scaricare le risorse
+void RaylibDrawing::UnloadResources() {
+    for (Texture2D &layer: layers)
+        UnloadTexture(layer);
+    UnloadTexture(sprites);
+    UnloadFont(font);
+
+    if (scene.id != 0) {
+        UnloadRenderTexture(scene);
+        scene = {};
+    }
+}
+
+void RaylibDrawing::BeginFrame(int _width, int _height) {
+    sceneActive = _width != GetScreenWidth() || _height != GetScreenHeight();
+
+    if (sceneActive) {
+        if (scene.texture.width != _width || scene.texture.height != _height) {
+            if (scene.id != 0)
+                UnloadRenderTexture(scene);
+            scene = LoadRenderTexture(_width, _height);
+        }
+        BeginTextureMode(scene);
+    } else {
+        BeginDrawing();
+    }
+    ClearBackground(RAYWHITE);
+}
+
+void RaylibDrawing::BeginOverlay(int _width, int _height) {
+    if (!sceneActive)
+        return;
+
+    // Una sola copia scalata della scena nella finestra (la texture è capovolta in OpenGL)
+    EndTextureMode();
+    BeginDrawing();
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(scene.texture.width), -static_cast<float>(scene.texture.height)};
+    Rectangle dest = {0.0f, 0.0f, static_cast<float>(_width), static_cast<float>(_height)};
+    DrawTexturePro(scene.texture, source, dest, Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+    sceneActive = false;
+}
+
+void RaylibDrawing::EndFrame() {
+    BeginOverlay(GetScreenWidth(), GetScreenHeight());
+    EndDrawing();
+}
+
+// Funzione per disegnare in un solo batch tutti i quadrilateri accodati
+void RaylibDrawing::FlushRoad() {
+    const std::vector<RoadQuad> &quads = roadList.getQuads();
+    size_t count = quads.size();
+
+    roadQuads = static_cast<int>(count);
+    roadDrawCalls = 0;
+
+    if (count > 0) {
+        roadDrawCalls = 1;
+        rlSetTexture(rlGetTextureIdDefault());
+
+        size_t done = 0;
+        while (done < count) {
+            size_t chunk = std::min(count - done, static_cast<size_t>(RL_DEFAULT_BATCH_BUFFER_ELEMENTS));
+
+            // Se il batch corrente non ha spazio, rlgl lo disegna e ne inizia un altro
+            if (rlCheckRenderBatchLimit(static_cast<int>(chunk * 4)))
+                roadDrawCalls++;
+
+            rlBegin(RL_QUADS);
+            for (size_t i = done; i < done + chunk; i++) {
+                const RoadQuad &q = quads[i];
+                rlColor4ub(q.color.r, q.color.g, q.color.b, q.color.a);
+
+                // I vertici vengono inviati sempre in senso antiorario sullo schermo
+                // per non essere scartati dal backface culling
+                float area = (q.x2 - q.x1) * (q.y3 - q.y1) - (q.y2 - q.y1) * (q.x3 - q.x1);
+                if (area <= 0.0f) {
+                    rlVertex2f(q.x1, q.y1);
+                    rlVertex2f(q.x2, q.y2);
+                    rlVertex2f(q.x3, q.y3);
+                    rlVertex2f(q.x4, q.y4);
+                } else {
+                    rlVertex2f(q.x4, q.y4);
+                    rlVertex2f(q.x3, q.y3);
+                    rlVertex2f(q.x2, q.y2);
+                    rlVertex2f(q.x1, q.y1);
+                }
+            }
+            rlEnd();
+
+            done += chunk;
+        }
+
+        rlSetTexture(0);
+    }
+
+    roadList.clear();
+}
+
+// Funzione per disegnare un elemento di sfondo
+void RaylibDrawing::DrawBackground(int _width, int _height, int layer, float rotation, float offset) {
+    Rectangle sourceRec;
+    Rectangle destRec;
+    BackgroundRect(_width, _height, layer, rotation, offset, sourceRec, destRec);
+
+    const Texture2D &texture = layers[layer];
+
+    // Una sola chiamata: la parte che esce dalla texture viene ripetuta dal wrap
+    if (repeatLayers || sourceRec.x + sourceRec.width <= texture.width) {
+        DrawTexturePro(texture, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
+        return;
+    }
+
+    // Senza wrap: la parte fino al bordo della texture e poi quella dall'inizio
+    float sourceW = texture.width - sourceRec.x;
+    int destW = static_cast<int>(destRec.width * (sourceW / sourceRec.width));
+    DrawTexturePro(texture, Rectangle{sourceRec.x, sourceRec.y, sourceW, sourceRec.height},
+                   Rectangle{destRec.x, destRec.y, static_cast<float>(destW), destRec.height}, {0, 0}, 0.0f, WHITE);
+    DrawTexturePro(texture, Rectangle{0.0f, sourceRec.y, sourceRec.width - sourceW, sourceRec.height},
+                   Rectangle{static_cast<float>(destW - 1), destRec.y, destRec.width - destW + 1, destRec.height},
+                   {0, 0}, 0.0f, WHITE);
+}
+
+int RaylibDrawing::DrawTexturedQuads(Texture2D texture, const SpriteInstance *instances, size_t count, Color color) {
+    if (count == 0)
+        return 0;
+
+    float texW = static_cast<float>(texture.width);
+    float texH = static_cast<float>(texture.height);
+    int drawCalls = 1;
+    rlSetTexture(texture.id);
+
+    size_t done = 0;
+    while (done < count) {
+        size_t chunk = std::min(count - done, static_cast<size_t>(RL_DEFAULT_BATCH_BUFFER_ELEMENTS));
+
+        if (rlCheckRenderBatchLimit(static_cast<int>(chunk * 4)))
+            drawCalls++;
+
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (size_t i = done; i < done + chunk; i++) {
+            const Rectangle &src = instances[i].source;
+            const Rectangle &dst = instances[i].dest;
+            float u1 = src.x / texW;
+            float v1 = src.y / texH;
+            float u2 = (src.x + src.width) / texW;
+            float v2 = (src.y + src.height) / texH;
+
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(dst.x, dst.y);
+            rlTexCoord2f(u1, v2);
+            rlVertex2f(dst.x, dst.y + dst.height);
+            rlTexCoord2f(u2, v2);
+            rlVertex2f(dst.x + dst.width, dst.y + dst.height);
+            rlTexCoord2f(u2, v1);
+            rlVertex2f(dst.x + dst.width, dst.y);
+        }
+        rlEnd();
+
+        done += chunk;
+    }
+
+    rlSetTexture(0);
+    return drawCalls;
+}
+
+// Funzione per disegnare in un solo batch tutti gli sprite accodati
+void RaylibDrawing::FlushSprites() {
+    const std::vector<SpriteInstance> &instances = spriteList.getInstances();
+
+    spriteCount = static_cast<int>(instances.size());
+    spriteDrawCalls = DrawTexturedQuads(sprites, instances.data(), instances.size(), WHITE);
+
+    spriteList.clear();
+}
+
+void RaylibDrawing::DrawRectangle(int x, int y, int _width, int _height, Color color) {
+    ::DrawRectangle(x, y, _width, _height, color);
+}
+
+void RaylibDrawing::DrawRectangleLines(int x, int y, int _width, int _height, Color color) {
+    ::DrawRectangleLines(x, y, _width, _height, color);
+}
+
+void RaylibDrawing::DrawText(const char *text, float x, float y, Color color) {
+    DrawTextEx(font, text, Vector2{x, y}, static_cast<float>(font.baseSize), 1, color);
+}
+
+void RaylibDrawing::DrawFPS(int x, int y) {
+    ::DrawFPS(x, y);
+}
+
+void RaylibDrawing::DrawGlyphs(const GlyphRun &run, Color color) {
+    DrawTexturedQuads(font.texture, run.glyphs, static_cast<size_t>(run.count), color);
+}
@@ -0,0 +1,38 @@
+#ifndef __RAYLIBDRAWING_HPP__
+#define __RAYLIBDRAWING_HPP__
+
+#include "raylib.h"
+#include "drawing.hpp"
+
+// Backend di disegno basato su raylib (OpenGL)
+class RaylibDrawing : public Drawing {
+    public:
+        void LoadResources() override;
+        void UnloadResources() override;
+        void BeginFrame(int _width, int _height) override;
+        void BeginOverlay(int _width, int _height) override;
+        void EndFrame() override;
+
+        void FlushRoad() override;
+        void DrawBackground(int _width, int _height, int layer, float rotation, float offset) override;
+        void FlushSprites() override;
+
+        void DrawRectangle(int x, int y, int _width, int _height, Color color) override;
+        void DrawRectangleLines(int x, int y, int _width, int _height, Color color) override;
+        void DrawText(const char *text, float x, float y, Color color) override;
+        void DrawFPS(int x, int y) override;
+        void DrawGlyphs(const GlyphRun &run, Color color) override;
+
+    private:
+        // Accoda quadrilateri con texture nel batch di rlgl, ritorna il numero di draw call
+        static int DrawTexturedQuads(Texture2D texture, const SpriteInstance *instances, size_t count, Color color);
+
+        Texture2D layers[BACKGROUND::LAYER_COUNT]; // Strati dello sfondo (texture che si ripetono)
+        bool repeatLayers = true;   // Il driver ripete texture non potenze di due (altrimenti due rettangoli)
+        Texture2D sprites;      // Spritesheet
+
+        RenderTexture2D scene = {}; // Scena alla risoluzione interna (se diversa dalla finestra)
+        bool sceneActive = false;   // La scena del frame corrente è disegnata in scene
+};
+
+#endif
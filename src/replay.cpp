@@ -0,0 +1,127 @@
+#include "replay.hpp"
+
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// Intestazione del file: firma e versione del formato
+static const char MAGIC[4] = {'O', 'R', 'R', 'P'};
+static const unsigned char VERSION = 1;
+
+// Interi senza segno a lunghezza variabile (7 bit per byte, little endian):
+// il file è lo stesso su PPC e su x86
+static void WriteVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static bool ReadVarint(const std::string &in, size_t &pos, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        unsigned char byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+void Replay::start(uint64_t _seed, const std::map<std::string, std::string> &_options) {
+    seed = _seed;
+    options = _options;
+    runs.clear();
+    totalSteps = 0;
+    run = 0;
+    runStep = 0;
+    played = 0;
+}
+
+void Replay::record(unsigned char input) {
+    if (!runs.empty() && runs.back().input == input && runs.back().count < UINT32_MAX)
+        runs.back().count++;
+    else
+        runs.push_back(Run{input, 1});
+    totalSteps++;
+}
+
+bool Replay::next(unsigned char &input) {
+    if (finished())
+        return false;
+
+    input = runs[run].input;
+    played++;
+    if (++runStep == runs[run].count) {
+        run++;
+        runStep = 0;
+    }
+    return true;
+}
+
+bool Replay::save(const std::string &path) const {
+    std::string out(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    WriteVarint(out, seed);
+
+    std::string text = json(options).dump();
+    WriteVarint(out, text.size());
+    out += text;
+
+    WriteVarint(out, runs.size());
+    for (const Run &r: runs) {
+        out.push_back(static_cast<char>(r.input));
+        WriteVarint(out, r.count);
+    }
+
+    std::ofstream f(path, std::ios::binary);
+    if (!f.good())
+        return false;
+    f.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return f.good();
+}
+
+bool Replay::load(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good())
+        return false;
+    std::string in((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    size_t pos = sizeof(MAGIC) + 1;
+    if (in.size() < pos || in.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0 ||
+        static_cast<unsigned char>(in[sizeof(MAGIC)]) != VERSION)
+        return false;
+
+    uint64_t fileSeed, length, count;
+    if (!ReadVarint(in, pos, fileSeed) || !ReadVarint(in, pos, length) || length > in.size() - pos)
+        return false;
+
+    json data = json::parse(in.substr(pos, length), nullptr, false);
+    if (data.is_discarded() || !data.is_object())
+        return false;
+    pos += length;
+
+    if (!ReadVarint(in, pos, count))
+        return false;
+
+    std::vector<Run> fileRuns;
+    size_t fileSteps = 0;
+    for (uint64_t n = 0; n < count; n++) {
+        uint64_t steps;
+        if (pos >= in.size())
+            return false;
+        unsigned char input = static_cast<unsigned char>(in[pos++]);
+        if (!ReadVarint(in, pos, steps) || steps == 0 || steps > UINT32_MAX)
+            return false;
+        fileRuns.push_back(Run{input, static_cast<uint32_t>(steps)});
+        fileSteps += steps;
+    }
+
+    start(fileSeed, data.get<std::map<std::string, std::string>>());
+    runs.swap(fileRuns);
+    totalSteps = fileSteps;
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef __REPLAY_HPP__
+#define __REPLAY_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Registrazione degli ingressi per passo della simulazione. Con il seme e le
+// opzioni della partita basta a ripetere la stessa identica simulazione: è il
+// carico di lavoro standard per i benchmark e i controlli di regressione.
+// Gli ingressi cambiano raramente tra un passo e l'altro, quindi nel file sono
+// salvati come sequenze (ingresso, numero di passi).
+class Replay
+{
+public:
+    // Bit dell'ingresso di un passo
+    enum Input : unsigned char {
+        LEFT = 1,
+        RIGHT = 2,
+        FASTER = 4,
+        SLOWER = 8
+    };
+
+    // Inizia una nuova registrazione
+    void start(uint64_t _seed, const std::map<std::string, std::string> &_options);
+
+    // Aggiunge l'ingresso del passo successivo
+    void record(unsigned char input);
+
+    // Ingresso del passo successivo in riproduzione, false a fine replay
+    bool next(unsigned char &input);
+
+    bool finished() const { return played >= totalSteps; }
+
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+    uint64_t getSeed() const { return seed; }
+    const std::map<std::string, std::string> &getOptions() const { return options; }
+    size_t steps() const { return totalSteps; }
+    size_t runCount() const { return runs.size(); }
+
+private:
+    struct Run {
+        unsigned char input;
+        uint32_t count;
+    };
+
+    uint64_t seed = 0;
+    std::map<std::string, std::string> options;
+    std::vector<Run> runs;
+    size_t totalSteps = 0;
+
+    // Posizione della riproduzione
+    size_t run = 0;
+    uint32_t runStep = 0;
+    size_t played = 0;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "road.hpp"
+
+void Road::clear(float _segmentLength) {
+    segmentLength = _segmentLength;
+    heights.assign(1, 0.0f);
+    curves.clear();
+    curveSum.assign(1, 0.0);
+    curveSum2.assign(1, 0.0);
+    colors.clear();
+    spriteStart.assign(1, 0);
+    sprites.clear();
+    pending.clear();
+}
+
+void Road::add(float curve, float y, unsigned char color) {
+    heights.push_back(y);
+    curves.push_back(curve);
+    colors.push_back(color);
+}
+
+void Road::addSprite(size_t n, const Sprite &sprite) {
+    pending.emplace_back(static_cast<unsigned int>(n), sprite);
+}
+
+void Road::finalize() {
+    // Conta gli sprite di ogni segmento e calcola gli indici di partenza
+    spriteStart.assign(curves.size() + 1, 0);
+    for (const auto &entry: pending)
+        spriteStart[entry.first + 1]++;
+    for (size_t n = 0; n < curves.size(); n++)
+        spriteStart[n + 1] += spriteStart[n];
+
+    // Distribuisce gli sprite mantenendo l'ordine di inserimento
+    std::vector<unsigned int> next(spriteStart.begin(), spriteStart.end() - 1);
+    sprites.resize(pending.size());
+    for (const auto &entry: pending)
+        sprites[next[entry.first]++] = entry.second;
+
+    pending.clear();
+    pending.shrink_to_fit();
+
+    // Somme prefisse di primo e secondo ordine delle curve
+    curveSum.assign(curves.size() + 1, 0.0);
+    curveSum2.assign(curves.size() + 1, 0.0);
+    for (size_t n = 0; n < curves.size(); n++) {
+        curveSum[n + 1] = curveSum[n] + curves[n];
+        curveSum2[n + 1] = curveSum2[n] + curveSum[n];
+    }
+}
+
+double Road::sum1(size_t i) const {
+    size_t total = curves.size();
+    size_t laps = i / total;
+    return laps * curveSum[total] + curveSum[i % total];
+}
+
+double Road::sum2(size_t i) const {
+    // Ogni giro completo aggiunge curveSum2[total] più la somma dei giri precedenti
+    // (curveSum[total] per ognuno dei loro total segmenti)
+    size_t total = curves.size();
+    size_t laps = i / total;
+    size_t rest = i % total;
+    double previous = total * (laps * (laps - 1) / 2.0) + static_cast<double>(rest) * laps;
+    return laps * curveSum2[total] + previous * curveSum[total] + curveSum2[rest];
+}
+
+float Road::curveOffset(size_t base, float basePercent, size_t n) const {
+    double dx = -curves[base] * static_cast<double>(basePercent);
+    return static_cast<float>(n * dx + (sum2(base + n) - sum2(base)) - n * sum1(base));
+}
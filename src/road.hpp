@@ -0,0 +1,65 @@
+#ifndef __ROAD_HPP__
+#define __ROAD_HPP__
+
+#include <vector>
+#include <cstddef>
+
+#include "common.hpp"
+
+// Archivio della geometria statica della strada.
+// I dati immutabili dei segmenti sono tenuti in array compatti separati; i dati
+// calcolati ad ogni frame vivono nel buffer di Projection.
+class Road
+{
+public:
+    // Svuota la strada
+    void clear(float _segmentLength);
+
+    // Aggiunge un segmento che termina all'altezza y
+    void add(float curve, float y, unsigned char color);
+
+    // Aggiunge uno sprite al segmento n (valido fino alla chiamata di finalize)
+    void addSprite(size_t n, const Sprite &sprite);
+
+    // Compatta gli sprite in un unico array indicizzato per segmento e calcola le
+    // somme prefisse delle curve
+    void finalize();
+
+    size_t size() const { return curves.size(); }
+    bool empty() const { return curves.empty(); }
+
+    float z(size_t n) const { return n * segmentLength; }                   // Z iniziale del segmento
+    float startY(size_t n) const { return heights[n]; }                     // Altezza di p1
+    float endY(size_t n) const { return heights[n + 1]; }                   // Altezza di p2
+    float lastY() const { return heights.back(); }
+    float curve(size_t n) const { return curves[n]; }
+    unsigned char color(size_t n) const { return colors[n]; }
+    void setColor(size_t n, unsigned char color) { colors[n] = color; }
+
+    // Spostamento laterale del segmento base + n rispetto al segmento base, in forma chiusa.
+    // Equivale ad accumulare x += dx; dx += curve partendo da dx = -curve(base) * basePercent,
+    // ma ogni n è indipendente dagli altri. base + n può superare size() (giro successivo).
+    float curveOffset(size_t base, float basePercent, size_t n) const;
+
+    // Sprite del segmento n
+    const Sprite *spritesBegin(size_t n) const { return sprites.data() + spriteStart[n]; }
+    const Sprite *spritesEnd(size_t n) const { return sprites.data() + spriteStart[n + 1]; }
+
+private:
+    float segmentLength = 200.0f;
+    std::vector<float> heights = {0.0f};    // Altezza dei confini dei segmenti (size() + 1 valori)
+    std::vector<float> curves;              // Curva dei segmenti
+    std::vector<double> curveSum;           // curveSum[i] = somma delle curve dei segmenti < i (size() + 1 valori)
+    std::vector<double> curveSum2;          // curveSum2[i] = somma di curveSum[j] per j < i (size() + 1 valori)
+    std::vector<unsigned char> colors;      // Indice del colore nella palette
+    std::vector<unsigned int> spriteStart;  // Primo sprite di ogni segmento (size() + 1 valori)
+    std::vector<Sprite> sprites;            // Sprite di tutti i segmenti
+
+    std::vector<std::pair<unsigned int, Sprite>> pending; // Sprite aggiunti prima di finalize
+
+    // Somme prefisse estese oltre la fine della strada (i qualsiasi, la strada si ripete)
+    double sum1(size_t i) const;
+    double sum2(size_t i) const;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#include "roadlines.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+void RoadLines::reset(int height) {
+    centerX.resize(height);
+    halfWidth.resize(height);
+    fog.resize(height);
+    palette.assign(height, EMPTY);
+}
+
+void RoadLines::addSegment(float x1, float y1, float w1, float x2, float y2, float w2, unsigned char color,
+                           float segmentFog, float clipY) {
+    if (y1 <= y2)
+        return;
+
+    // Righe il cui centro cade nel segmento, come per il riempimento dei poligoni
+    int first = std::max(0, static_cast<int>(std::ceil(y2 - 0.5f)));
+    int last = std::min(size(), static_cast<int>(std::ceil(std::min(y1, clipY) - 0.5f)));
+
+    float scale = 1.0f / (y1 - y2);
+    for (int row = first; row < last; row++) {
+        if (palette[row] != EMPTY)
+            continue;
+
+        float t = (y1 - (row + 0.5f)) * scale;
+        centerX[row] = x1 + (x2 - x1) * t;
+        halfWidth[row] = w1 + (w2 - w1) * t;
+        palette[row] = color;
+        fog[row] = segmentFog;
+    }
+}
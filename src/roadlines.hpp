@@ -0,0 +1,30 @@
+#ifndef __ROADLINES_HPP__
+#define __ROADLINES_HPP__
+
+#include <vector>
+
+// Tabella per riga dello schermo usata dal motore della strada a linee (come
+// l'hardware originale): per ogni riga il centro della strada, la semi larghezza e
+// la banda di colore. Ogni riga viene scritta una sola volta, dal segmento più vicino.
+class RoadLines
+{
+public:
+    static constexpr unsigned char EMPTY = 0xFF; // Riga senza strada (si vede lo sfondo)
+
+    // Svuota la tabella per uno schermo alto height righe
+    void reset(int height);
+
+    // Riempie le righe libere coperte dal segmento tra (x1, y1, w1) in basso e
+    // (x2, y2, w2) in alto, fermandosi alla riga clipY
+    void addSegment(float x1, float y1, float w1, float x2, float y2, float w2, unsigned char palette, float fog,
+                    float clipY);
+
+    int size() const { return static_cast<int>(palette.size()); }
+
+    std::vector<float> centerX;
+    std::vector<float> halfWidth;
+    std::vector<unsigned char> palette;    // Indice in SEGMENT_COLORS o EMPTY
+    std::vector<float> fog;                // Fattore della nebbia del segmento
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef __SIMD_HPP__
+#define __SIMD_HPP__
+
+// Rilevamento di SSE2 per tutti i compilatori: GCC e Clang definiscono __SSE2__,
+// MSVC solo _M_X64 (SSE2 è sempre presente) o _M_IX86_FP >= 2 (/arch:SSE2).
+// Sulle altre architetture (PowerPC di OS4) si usano le versioni scalari.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Indice del bit a 1 meno significativo (mask diverso da zero)
+static inline int LowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#endif
@@ -0,0 +1,565 @@
+#include "softwaredrawing.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+#include "simd.hpp"
+
+static inline uint32_t PackColor(Color color) {
+    uint32_t value;
+    memcpy(&value, &color, sizeof(value));
+    return value;
+}
+
+static inline unsigned int AlphaOf(uint32_t value) {
+    unsigned char c[4];
+    memcpy(c, &value, 4);
+    return c[3];
+}
+
+// Converte una coordinata in pixel evitando overflow per valori fuori schermo
+static inline int ToPixel(float value) {
+    return static_cast<int>(std::ceil(std::max(-1.0e6f, std::min(value, 1.0e6f)) - 0.5f));
+}
+
+// Riempie count pixel con lo stesso colore (4 pixel per istruzione dove disponibile SSE2)
+static inline void FillSpan(uint32_t *dst, int count, uint32_t value) {
+    int i = 0;
+#if defined(HAVE_SSE2)
+    __m128i v = _mm_set1_epi32(static_cast<int>(value));
+    for (; i + 16 <= count; i += 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), v);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 12), v);
+    }
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+#endif
+    for (; i < count; i++)
+        dst[i] = value;
+}
+
+// Miscela un pixel sorgente non opaco sul pixel di destinazione
+static inline uint32_t BlendPixel(uint32_t dst, uint32_t src) {
+    unsigned char s[4], d[4];
+    memcpy(s, &src, 4);
+    memcpy(d, &dst, 4);
+    unsigned int a = s[3];
+    unsigned int ia = 255 - a;
+    d[0] = static_cast<unsigned char>((s[0] * a + d[0] * ia + 127) / 255);
+    d[1] = static_cast<unsigned char>((s[1] * a + d[1] * ia + 127) / 255);
+    d[2] = static_cast<unsigned char>((s[2] * a + d[2] * ia + 127) / 255);
+    d[3] = static_cast<unsigned char>(a + (d[3] * ia + 127) / 255);
+    memcpy(&dst, d, 4);
+    return dst;
+}
+
+static inline uint32_t TintPixel(uint32_t value, Color tint) {
+    unsigned char c[4];
+    memcpy(c, &value, 4);
+    c[0] = static_cast<unsigned char>(c[0] * tint.r / 255);
+    c[1] = static_cast<unsigned char>(c[1] * tint.g / 255);
+    c[2] = static_cast<unsigned char>(c[2] * tint.b / 255);
+    c[3] = static_cast<unsigned char>(c[3] * tint.a / 255);
+    memcpy(&value, c, 4);
+    return value;
+}
+
+static inline void BlendSpan(uint32_t *dst, int count, uint32_t value) {
+    for (int i = 0; i < count; i++)
+        dst[i] = BlendPixel(dst[i], value);
+}
+
+SoftwareDrawing::SoftwareDrawing(bool _present, const std::string &_dumpPrefix, int _dumpEvery, int threads)
+    : pool(threads), present(_present), dumpPrefix(_dumpPrefix), dumpEvery(std::max(1, _dumpEvery)) {
+}
+
+void SoftwareDrawing::LoadSurface(Surface &surface, Image image) {
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    surface.width = image.width;
+    surface.height = image.height;
+    surface.pixels.resize(static_cast<size_t>(image.width) * image.height);
+    if (image.data != nullptr)
+        memcpy(surface.pixels.data(), image.data, surface.pixels.size() * sizeof(uint32_t));
+    UnloadImage(image);
+}
+
+void SoftwareDrawing::LoadSurface(Surface &surface, const char *fileName) {
+    LoadSurface(surface, LoadImage(fileName)); // Solo memoria CPU
+}
+
+// Carica il font come fa LoadFontEx, ma tiene l'atlante dei glifi in memoria CPU
+void SoftwareDrawing::LoadFont(const char *fileName, int fontSize) {
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    if (data == nullptr)
+        return;
+
+    font.baseSize = fontSize;
+    font.glyphCount = 250;
+    font.glyphPadding = 4;
+    font.glyphs = LoadFontData(data, dataSize, font.baseSize, nullptr, font.glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+
+    if (font.glyphs != nullptr)
+        LoadSurface(fontAtlas, GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, font.glyphPadding, 0));
+}
+
+void SoftwareDrawing::LoadResources() {
+    // Ogni strato dello sfondo in una superficie propria, per poterlo ripetere orizzontalmente
+    Image image = LoadImage("resources/images/background.png");
+    for (int i = 0; i < BACKGROUND::LAYER_COUNT; i++) {
+        const Sprite &layer = BACKGROUND::LAYERS[i];
+        LoadSurface(layers[i], ImageFromImage(image, Rectangle{static_cast<float>(layer.x), static_cast<float>(layer.y),
+                                                               static_cast<float>(layer.w), static_cast<float>(layer.h)}));
+    }
+    UnloadImage(image);
+
+    LoadSurface(sprites, "resources/images/sprites.png");
+    LoadFont("resources/font/Retroica.ttf", 24);
+}
+
+void SoftwareDrawing::UnloadResources() {
+    for (Surface &layer: layers)
+        layer = Surface();
+    skyCache.clear();
+    skyValid = false;
+    sprites = Surface();
+    fontAtlas = Surface();
+
+    if (font.glyphs != nullptr) {
+        UnloadFontData(font.glyphs, font.glyphCount);
+        MemFree(font.recs);
+        font = {};
+    }
+
+    if (target.id != 0) {
+        UnloadTexture(target);
+        target = {};
+    }
+}
+
+void SoftwareDrawing::BeginFrame(int _width, int _height) {
+    // La scena viene rasterizzata nel buffer della risoluzione interna
+    scenePixels.resize(static_cast<size_t>(_width) * _height);
+    canvas = scenePixels.data();
+    canvasWidth = _width;
+    canvasHeight = _height;
+    clearCanvas = true;
+    overlay = false;
+    backendTime = 0.0;
+}
+
+void SoftwareDrawing::BeginOverlay(int _width, int _height) {
+    if (overlay)
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    Rasterize();
+
+    if (_width != fbWidth || _height != fbHeight) {
+        fbWidth = _width;
+        fbHeight = _height;
+        pixels.assign(static_cast<size_t>(fbWidth) * fbHeight, 0);
+
+        if (present) {
+            if (target.id != 0)
+                UnloadTexture(target);
+            Image image = GenImageColor(fbWidth, fbHeight, BLANK);
+            target = LoadTextureFromImage(image);
+            UnloadImage(image);
+        }
+    }
+
+    if (canvasWidth == fbWidth && canvasHeight == fbHeight)
+        std::swap(pixels, scenePixels);
+    else
+        Upscale();
+
+    // L'HUD viene disegnato sopra la scena alla risoluzione della finestra
+    canvas = pixels.data();
+    canvasWidth = fbWidth;
+    canvasHeight = fbHeight;
+    clearCanvas = false;
+    overlay = true;
+    backendTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Scala la scena alla risoluzione della finestra (nearest neighbour, a strisce in parallelo)
+void SoftwareDrawing::Upscale() {
+    int sourceWidth = canvasWidth;
+    int sourceHeight = canvasHeight;
+    uint32_t stepU = (static_cast<uint32_t>(sourceWidth) << 16) / fbWidth;
+    int strips = (fbHeight + STRIP_HEIGHT - 1) / STRIP_HEIGHT;
+
+    pool.parallelFor(strips, [this, sourceWidth, sourceHeight, stepU](int strip) {
+        int rowEnd = std::min(fbHeight, (strip + 1) * STRIP_HEIGHT);
+        for (int y = strip * STRIP_HEIGHT; y < rowEnd; y++) {
+            int v = static_cast<int>(static_cast<int64_t>(y) * sourceHeight / fbHeight);
+            const uint32_t *src = scenePixels.data() + static_cast<size_t>(v) * sourceWidth;
+            uint32_t *dst = pixels.data() + static_cast<size_t>(y) * fbWidth;
+
+            uint32_t u = stepU / 2;
+            for (int x = 0; x < fbWidth; x++, u += stepU)
+                dst[x] = src[u >> 16];
+        }
+    });
+}
+
+void SoftwareDrawing::EndFrame() {
+    BeginOverlay(canvasWidth, canvasHeight);
+
+    auto start = std::chrono::steady_clock::now();
+    Rasterize();
+    backendTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (present) {
+        UpdateTexture(target, pixels.data());
+        BeginDrawing();
+        DrawTexture(target, 0, 0, WHITE);
+        EndDrawing();
+    } else {
+        auto now = std::chrono::steady_clock::now();
+        if (frameCounter > 0) {
+            double elapsed = std::chrono::duration<double>(now - lastFrame).count();
+            frameSeconds = frameSeconds > 0.0 ? frameSeconds + (elapsed - frameSeconds) * 0.1 : elapsed;
+        }
+        lastFrame = now;
+    }
+
+    if (!dumpPrefix.empty() && (frameCounter % dumpEvery) == 0) {
+        char fileName[512];
+        snprintf(fileName, sizeof(fileName), "%s%05d.png", dumpPrefix.c_str(), frameCounter / dumpEvery);
+        Image image = {pixels.data(), fbWidth, fbHeight, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        ExportImage(image, fileName);
+    }
+    frameCounter++;
+}
+
+// Riempie un quadrilatero convesso campionando ogni riga al centro del pixel
+void SoftwareDrawing::FillQuad(const RoadQuad &quad, int rowBegin, int rowEnd) {
+    const float xs[4] = {quad.x1, quad.x2, quad.x3, quad.x4};
+    const float ys[4] = {quad.y1, quad.y2, quad.y3, quad.y4};
+
+    float minY = std::min(std::min(ys[0], ys[1]), std::min(ys[2], ys[3]));
+    float maxY = std::max(std::max(ys[0], ys[1]), std::max(ys[2], ys[3]));
+
+    int y0 = std::max(rowBegin, ToPixel(minY));
+    int y1 = std::min(rowEnd, ToPixel(maxY));
+    if (y0 >= y1)
+        return;
+
+    uint32_t value = PackColor(quad.color);
+    bool opaque = quad.color.a == 255;
+
+    for (int y = y0; y < y1; y++) {
+        float sy = y + 0.5f;
+        float left = static_cast<float>(canvasWidth);
+        float right = 0.0f;
+
+        for (int e = 0; e < 4; e++) {
+            float ax = xs[e], ay = ys[e];
+            float bx = xs[(e + 1) & 3], by = ys[(e + 1) & 3];
+            if ((sy < ay) == (sy < by))
+                continue; // Il lato non attraversa questa riga
+            float x = ax + (sy - ay) * (bx - ax) / (by - ay);
+            left = std::min(left, x);
+            right = std::max(right, x);
+        }
+
+        int x0 = std::max(0, ToPixel(left));
+        int x1 = std::min(canvasWidth, ToPixel(right));
+        if (x0 >= x1)
+            continue;
+
+        uint32_t *row = canvas + static_cast<size_t>(y) * canvasWidth;
+        if (opaque)
+            FillSpan(row + x0, x1 - x0, value);
+        else
+            BlendSpan(row + x0, x1 - x0, value);
+    }
+}
+
+void SoftwareDrawing::FillRect(int x, int y, int w, int h, Color color, int rowBegin, int rowEnd) {
+    int x0 = std::max(0, x);
+    int x1 = std::min(canvasWidth, x + w);
+    int y0 = std::max(rowBegin, y);
+    int y1 = std::min(rowEnd, y + h);
+    if (x0 >= x1 || y0 >= y1 || color.a == 0)
+        return;
+
+    uint32_t value = PackColor(color);
+    for (int row = y0; row < y1; row++) {
+        uint32_t *dst = canvas + static_cast<size_t>(row) * canvasWidth + x0;
+        if (color.a == 255)
+            FillSpan(dst, x1 - x0, value);
+        else
+            BlendSpan(dst, x1 - x0, value);
+    }
+}
+
+// Copia scalata (nearest neighbour) con trasparenza e colore di modulazione
+void SoftwareDrawing::Blit(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, int rowBegin,
+                           int rowEnd, Color tint) {
+    if (destRec.width <= 0.0f || destRec.height <= 0.0f || sourceRec.width <= 0.0f || sourceRec.height <= 0.0f)
+        return;
+
+    int x0 = std::max(0, ToPixel(destRec.x));
+    int x1 = std::min(canvasWidth, ToPixel(destRec.x + destRec.width));
+    int y0 = std::max(rowBegin, ToPixel(destRec.y));
+    int y1 = std::min(rowEnd, ToPixel(destRec.y + destRec.height));
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    float stepU = sourceRec.width / destRec.width;
+    float stepV = sourceRec.height / destRec.height;
+    int minU = std::max(0, static_cast<int>(sourceRec.x));
+    int maxU = std::min(source.width, static_cast<int>(std::ceil(sourceRec.x + sourceRec.width))) - 1;
+    int minV = std::max(0, static_cast<int>(sourceRec.y));
+    int maxV = std::min(source.height, static_cast<int>(std::ceil(sourceRec.y + sourceRec.height))) - 1;
+    if (minU > maxU || minV > maxV)
+        return;
+
+    // Coordinate u in virgola fissa 16.16 per la prima colonna
+    float u0 = sourceRec.x + (x0 + 0.5f - destRec.x) * stepU;
+    int32_t fixedU0 = static_cast<int32_t>(u0 * 65536.0f);
+    int32_t fixedStep = static_cast<int32_t>(stepU * 65536.0f);
+    bool tinted = PackColor(tint) != PackColor(WHITE);
+
+    for (int y = y0; y < y1; y++) {
+        int v = std::min(maxV, std::max(minV, static_cast<int>(sourceRec.y + (y + 0.5f - destRec.y) * stepV)));
+        const uint32_t *src = source.pixels.data() + static_cast<size_t>(v) * source.width;
+        uint32_t *dst = canvas + static_cast<size_t>(y) * canvasWidth;
+
+        int32_t fixedU = fixedU0;
+        for (int x = x0; x < x1; x++, fixedU += fixedStep) {
+            uint32_t texel = src[std::min(maxU, std::max(minU, fixedU >> 16))];
+            if (tinted)
+                texel = TintPixel(texel, tint);
+            unsigned int alpha = AlphaOf(texel);
+            if (alpha == 255)
+                dst[x] = texel;
+            else if (alpha != 0)
+                dst[x] = BlendPixel(dst[x], texel);
+        }
+    }
+}
+
+// Copia scalata di uno strato dello sfondo: le colonne oltre il bordo destro ripartono da sinistra
+void SoftwareDrawing::BlitWrap(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, int rowBegin,
+                               int rowEnd) {
+    if (destRec.width <= 0.0f || destRec.height <= 0.0f || source.width == 0 || source.height == 0)
+        return;
+
+    int x0 = std::max(0, ToPixel(destRec.x));
+    int x1 = std::min(canvasWidth, ToPixel(destRec.x + destRec.width));
+    int y0 = std::max(rowBegin, ToPixel(destRec.y));
+    int y1 = std::min(rowEnd, ToPixel(destRec.y + destRec.height));
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    float stepU = sourceRec.width / destRec.width;
+    float stepV = sourceRec.height / destRec.height;
+    int32_t wrapU = source.width << 16;
+
+    float u0 = std::fmod(sourceRec.x + (x0 + 0.5f - destRec.x) * stepU, static_cast<float>(source.width));
+    if (u0 < 0.0f)
+        u0 += source.width;
+    int32_t fixedU0 = std::min(wrapU - 1, static_cast<int32_t>(u0 * 65536.0f));
+    int32_t fixedStep = static_cast<int32_t>(stepU * 65536.0f) % wrapU;
+
+    for (int y = y0; y < y1; y++) {
+        int v = std::min(source.height - 1, std::max(0, static_cast<int>(sourceRec.y + (y + 0.5f - destRec.y) * stepV)));
+        const uint32_t *src = source.pixels.data() + static_cast<size_t>(v) * source.width;
+        uint32_t *dst = canvas + static_cast<size_t>(y) * canvasWidth;
+
+        int32_t fixedU = fixedU0;
+        for (int x = x0; x < x1; x++) {
+            uint32_t texel = src[fixedU >> 16];
+            unsigned int alpha = AlphaOf(texel);
+            if (alpha == 255)
+                dst[x] = texel;
+            else if (alpha != 0)
+                dst[x] = BlendPixel(dst[x], texel);
+
+            fixedU += fixedStep;
+            if (fixedU >= wrapU)
+                fixedU -= wrapU;
+        }
+    }
+}
+
+void SoftwareDrawing::AddCommand(Command::Type type, int index, float top, float bottom) {
+    int rowBegin = std::max(0, ToPixel(top));
+    int rowEnd = std::min(canvasHeight, ToPixel(bottom));
+    if (rowBegin < rowEnd)
+        commands.push_back(Command{type, index, rowBegin, rowEnd});
+}
+
+void SoftwareDrawing::AddRect(int x, int y, int w, int h, Color color) {
+    if (w <= 0 || h <= 0 || color.a == 0)
+        return;
+    rects.push_back(RectCommand{x, y, w, h, color});
+    AddCommand(Command::RECT, static_cast<int>(rects.size()) - 1, static_cast<float>(y), static_cast<float>(y + h));
+}
+
+void SoftwareDrawing::AddBlit(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, Color tint,
+                              bool wrap) {
+    blits.push_back(BlitCommand{&source, sourceRec, destRec, tint, wrap});
+    AddCommand(Command::BLIT, static_cast<int>(blits.size()) - 1, destRec.y, destRec.y + destRec.height);
+}
+
+void SoftwareDrawing::Rasterize() {
+    int strips = (canvasHeight + STRIP_HEIGHT - 1) / STRIP_HEIGHT;
+    if (static_cast<int>(bins.size()) < strips)
+        bins.resize(strips);
+    for (int strip = 0; strip < strips; strip++)
+        bins[strip].clear();
+
+    // I comandi sono aggiunti in ordine di disegno, quindi ogni striscia li riceve dal fondo in avanti
+    for (int i = 0; i < static_cast<int>(commands.size()); i++) {
+        const Command &command = commands[i];
+        int last = (command.rowEnd - 1) / STRIP_HEIGHT;
+        for (int strip = command.rowBegin / STRIP_HEIGHT; strip <= last; strip++)
+            bins[strip].push_back(i);
+    }
+
+    if (skyPending) {
+        skyHit = skyValid && skyKey == cachedSky;
+        if (!skyHit)
+            skyCache.resize(static_cast<size_t>(canvasWidth) * canvasHeight);
+    }
+
+    pool.parallelFor(strips, [this](int strip) { RasterizeStrip(strip); });
+
+    if (skyPending) {
+        cachedSky = skyKey;
+        skyValid = true;
+        skyPending = false;
+    }
+
+    commands.clear();
+    quads.clear();
+    rects.clear();
+    blits.clear();
+}
+
+void SoftwareDrawing::RasterizeStrip(int strip) {
+    int rowBegin = strip * STRIP_HEIGHT;
+    int rowEnd = std::min(canvasHeight, rowBegin + STRIP_HEIGHT);
+
+    uint32_t *rows = canvas + static_cast<size_t>(rowBegin) * canvasWidth;
+    int count = (rowEnd - rowBegin) * canvasWidth;
+
+    if (skyPending) {
+        uint32_t *cached = skyCache.data() + static_cast<size_t>(rowBegin) * canvasWidth;
+        if (skyHit) {
+            memcpy(rows, cached, count * sizeof(uint32_t));
+        } else {
+            FillSpan(rows, count, PackColor(RAYWHITE));
+            BlitWrap(layers[BACKGROUND::LAYER_SKY], skySource, skyDest, rowBegin, rowEnd);
+            memcpy(cached, rows, count * sizeof(uint32_t));
+        }
+    } else if (clearCanvas) {
+        FillSpan(rows, count, PackColor(RAYWHITE));
+    }
+
+    for (int i: bins[strip]) {
+        const Command &command = commands[i];
+        switch (command.type) {
+            case Command::QUAD:
+                FillQuad(quads[command.index], rowBegin, rowEnd);
+                break;
+            case Command::RECT: {
+                const RectCommand &rect = rects[command.index];
+                FillRect(rect.x, rect.y, rect.width, rect.height, rect.color, rowBegin, rowEnd);
+                break;
+            }
+            case Command::BLIT: {
+                const BlitCommand &blit = blits[command.index];
+                if (blit.wrap)
+                    BlitWrap(*blit.source, blit.sourceRec, blit.destRec, rowBegin, rowEnd);
+                else
+                    Blit(*blit.source, blit.sourceRec, blit.destRec, rowBegin, rowEnd, blit.tint);
+                break;
+            }
+        }
+    }
+}
+
+void SoftwareDrawing::FlushRoad() {
+    const std::vector<RoadQuad> &frameQuads = roadList.getQuads();
+
+    for (const RoadQuad &quad: frameQuads) {
+        float top = std::min(std::min(quad.y1, quad.y2), std::min(quad.y3, quad.y4));
+        float bottom = std::max(std::max(quad.y1, quad.y2), std::max(quad.y3, quad.y4));
+        quads.push_back(quad);
+        AddCommand(Command::QUAD, static_cast<int>(quads.size()) - 1, top, bottom);
+    }
+
+    roadQuads = static_cast<int>(frameQuads.size());
+    roadDrawCalls = 0;
+    roadList.clear();
+}
+
+void SoftwareDrawing::DrawBackground(int _width, int _height, int layer, float rotation, float offset) {
+    Rectangle sourceRec;
+    Rectangle destRec;
+    BackgroundRect(_width, _height, layer, rotation, offset, sourceRec, destRec);
+
+    // Il cielo disegnato per primo sul frame pulito può venire dalla cache
+    if (layer == BACKGROUND::LAYER_SKY && commands.empty() && clearCanvas) {
+        skyKey = SkyKey{rotation, offset, canvasWidth, canvasHeight};
+        skySource = sourceRec;
+        skyDest = destRec;
+        skyPending = true;
+        return;
+    }
+
+    AddBlit(layers[layer], sourceRec, destRec, WHITE, true);
+}
+
+void SoftwareDrawing::FlushSprites() {
+    const std::vector<SpriteInstance> &instances = spriteList.getInstances();
+
+    for (const SpriteInstance &instance: instances)
+        AddBlit(sprites, instance.source, instance.dest);
+
+    spriteCount = static_cast<int>(instances.size());
+    spriteDrawCalls = 0;
+    spriteList.clear();
+}
+
+void SoftwareDrawing::DrawRectangle(int x, int y, int _width, int _height, Color color) {
+    AddRect(x, y, _width, _height, color);
+}
+
+void SoftwareDrawing::DrawRectangleLines(int x, int y, int _width, int _height, Color color) {
+    AddRect(x, y, _width, 1, color);
+    AddRect(x, y + _height - 1, _width, 1, color);
+    AddRect(x, y + 1, 1, _height - 2, color);
+    AddRect(x + _width - 1, y + 1, 1, _height - 2, color);
+}
+
+// Disegna il testo con la stessa impaginazione di DrawTextEx (spaziatura 1)
+void SoftwareDrawing::DrawText(const char *text, float x, float y, Color color) {
+    GlyphRun run;
+    LayoutText(text, x, y, run);
+    DrawGlyphs(run, color);
+}
+
+void SoftwareDrawing::DrawGlyphs(const GlyphRun &run, Color color) {
+    for (int i = 0; i < run.count; i++)
+        AddBlit(fontAtlas, run.glyphs[i].source, run.glyphs[i].dest, color);
+}
+
+void SoftwareDrawing::DrawFPS(int x, int y) {
+    char text[32];
+    int fps = present ? GetFPS() : (frameSeconds > 0.0 ? static_cast<int>(std::lround(1.0 / frameSeconds)) : 0);
+    snprintf(text, sizeof(text), "%2i FPS", fps);
+    DrawText(text, static_cast<float>(x), static_cast<float>(y), Color{0, 158, 47, 255});
+}
@@ -0,0 +1,168 @@
+#ifndef __SOFTWAREDRAWING_HPP__
+#define __SOFTWAREDRAWING_HPP__
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <chrono>
+
+#include "raylib.h"
+#include "drawing.hpp"
+#include "threadpool.hpp"
+
+// Backend di disegno software: rasterizza la scena in un framebuffer RGBA in memoria,
+// senza usare la GPU. Il frame può essere mostrato nella finestra, salvato su disco
+// o letto direttamente con GetPixels.
+// I comandi di disegno vengono registrati durante il frame e rasterizzati in EndFrame:
+// ogni comando è assegnato alle strisce orizzontali che copre e le strisce vengono
+// disegnate in parallelo, ognuna con i propri comandi nell'ordine originale.
+class SoftwareDrawing : public Drawing {
+    public:
+        // present: copia il framebuffer nella finestra alla fine di ogni frame (se false non
+        // servono né la finestra né il contesto GL)
+        // dumpPrefix: se non vuoto salva un frame ogni dumpEvery come <dumpPrefix>NNNNN.png
+        // threads: thread usati per rasterizzare, 0 = uno per core
+        SoftwareDrawing(bool _present, const std::string &_dumpPrefix, int _dumpEvery, int threads = 0);
+
+        void LoadResources() override;
+        void UnloadResources() override;
+        void BeginFrame(int _width, int _height) override;
+        void BeginOverlay(int _width, int _height) override;
+        void EndFrame() override;
+
+        void FlushRoad() override;
+        void DrawBackground(int _width, int _height, int layer, float rotation, float offset) override;
+        void FlushSprites() override;
+
+        void DrawRectangle(int x, int y, int _width, int _height, Color color) override;
+        void DrawRectangleLines(int x, int y, int _width, int _height, Color color) override;
+        void DrawText(const char *text, float x, float y, Color color) override;
+        void DrawFPS(int x, int y) override;
+        void DrawGlyphs(const GlyphRun &run, Color color) override;
+
+        // Framebuffer dell'ultimo frame alla risoluzione della finestra (RGBA, una riga dopo l'altra)
+        const uint32_t *GetPixels() const { return pixels.data(); }
+        int GetWidth() const { return fbWidth; }
+        int GetHeight() const { return fbHeight; }
+
+    private:
+        // Immagine RGBA in memoria
+        struct Surface
+        {
+            std::vector<uint32_t> pixels;
+            int width = 0;
+            int height = 0;
+        };
+
+        static void LoadSurface(Surface &surface, const char *fileName);
+        static void LoadSurface(Surface &surface, Image image);
+        void LoadFont(const char *fileName, int fontSize);
+
+        // Altezza in pixel delle strisce in cui viene diviso il framebuffer
+        static constexpr int STRIP_HEIGHT = 16;
+
+        // Comando registrato durante il frame
+        struct Command
+        {
+            enum Type : unsigned char { QUAD, RECT, BLIT };
+            Type type;
+            int index;      // Posizione in quads, rects o blits
+            int rowBegin;   // Righe coperte [rowBegin, rowEnd)
+            int rowEnd;
+        };
+
+        struct RectCommand
+        {
+            int x, y, width, height;
+            Color color;
+        };
+
+        struct BlitCommand
+        {
+            const Surface *source;
+            Rectangle sourceRec;
+            Rectangle destRec;
+            Color tint;
+            bool wrap;      // Strato dello sfondo che si ripete orizzontalmente
+        };
+
+        // Parametri con cui è stato disegnato il cielo
+        struct SkyKey
+        {
+            float rotation, offset;
+            int width, height;
+
+            bool operator==(const SkyKey &other) const {
+                return rotation == other.rotation && offset == other.offset && width == other.width &&
+                       height == other.height;
+            }
+        };
+
+        void AddCommand(Command::Type type, int index, float top, float bottom);
+        void AddRect(int x, int y, int w, int h, Color color);
+        void AddBlit(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, Color tint = WHITE,
+                     bool wrap = false);
+
+        // Rasterizza tutti i comandi del frame e svuota le liste
+        void Rasterize();
+        void RasterizeStrip(int strip);
+        // Copia la scena (risoluzione interna) nel framebuffer della finestra
+        void Upscale();
+
+        // Primitive di rasterizzazione, limitate alle righe [rowBegin, rowEnd)
+        void FillQuad(const RoadQuad &quad, int rowBegin, int rowEnd);
+        void FillRect(int x, int y, int w, int h, Color color, int rowBegin, int rowEnd);
+        void Blit(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, int rowBegin, int rowEnd,
+                  Color tint = WHITE);
+        void BlitWrap(const Surface &source, const Rectangle &sourceRec, const Rectangle &destRec, int rowBegin, int rowEnd);
+
+        std::vector<uint32_t> pixels;       // Frame finale alla risoluzione della finestra
+        int fbWidth = 0;
+        int fbHeight = 0;
+        std::vector<uint32_t> scenePixels;  // Scena alla risoluzione interna
+
+        // Buffer in cui vengono rasterizzati i comandi (scena o frame finale)
+        uint32_t *canvas = nullptr;
+        int canvasWidth = 0;
+        int canvasHeight = 0;
+        bool clearCanvas = true;
+        bool overlay = false;               // BeginOverlay già chiamato in questo frame
+
+        std::vector<Command> commands;
+        std::vector<RoadQuad> quads;
+        std::vector<RectCommand> rects;
+        std::vector<BlitCommand> blits;
+        std::vector<std::vector<int>> bins;     // Indici dei comandi di ogni striscia
+        ThreadPool pool;
+
+        Surface layers[BACKGROUND::LAYER_COUNT];    // Strati dello sfondo
+
+        // Cache del cielo: è il primo strato sopra lo sfondo pulito, quindi se rotazione e
+        // offset non cambiano le sue righe vengono copiate invece di essere ridisegnate
+        std::vector<uint32_t> skyCache;
+        SkyKey skyKey = {};                 // Cielo del frame corrente
+        SkyKey cachedSky = {};              // Cielo contenuto in skyCache
+        bool skyValid = false;
+        bool skyPending = false;            // Il cielo del frame corrente è da disegnare o copiare
+        bool skyHit = false;
+        Rectangle skySource = {};
+        Rectangle skyDest = {};
+        Surface sprites;
+
+        // Font dell'HUD rasterizzato in memoria (atlante dei glifi)
+        Surface fontAtlas;
+
+        bool present;
+        Texture2D target = {};  // Texture usata per mostrare il framebuffer nella finestra
+
+        std::string dumpPrefix;
+        int dumpEvery;
+        int frameCounter = 0;
+
+        // Senza finestra GetFPS non ha frame da contare: il tempo tra un frame e l'altro
+        // viene misurato qui (media mobile esponenziale)
+        std::chrono::steady_clock::time_point lastFrame;
+        double frameSeconds = 0.0;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "steering.hpp"
+
+#include <algorithm>
+
+#include "simd.hpp"
+
+void Steering::build(const Traffic &traffic, const std::vector<float> &reach) {
+    size_t count = traffic.nearCount();
+    size_t size = count > 0 ? 2 * count - 1 + LANES : 0;
+    offset.resize(size);
+    carReach.resize(size);
+    speed.resize(size);
+    segment.resize(size);
+
+    // L'inizio dell'anello si ripete in coda: le auto davanti non vanno mai riportate all'inizio
+    for (size_t k = 0, source = 0; k < size; k++, source = source + 1 == count ? 0 : source + 1) {
+        unsigned int car = traffic.nearCar(source);
+        offset[k] = traffic.offset[car];
+        carReach[k] = reach[traffic.type[car]];
+        speed[k] = traffic.speed[car];
+        segment[k] = static_cast<int>(traffic.segmentOf(car));
+    }
+}
+
+bool Steering::firstBlockingScalar(const Traffic &traffic, unsigned int car, size_t count, size_t limit,
+                                   size_t segments, float maxSpeed, float &result) const {
+    size_t rank = traffic.rankOf(car);
+
+    for (size_t i = rank + 1; i <= rank + count; i++) {
+        int distance = segment[i] - segment[rank];
+        if (distance < 0)
+            distance += static_cast<int>(segments);
+        if (static_cast<size_t>(distance) >= limit)
+            return false;
+        if (distance == 0)
+            continue;
+
+        if (speed[rank] > speed[i] && overlap(offset[rank], carReach[rank], offset[i], carReach[i])) {
+            result = steer(offset[rank], speed[rank], offset[i], speed[i], static_cast<float>(distance), maxSpeed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Steering::firstBlockingRing(const Traffic &traffic, const std::vector<float> &reach, unsigned int car,
+                                 size_t count, size_t limit, size_t segments, float maxSpeed, float &result) {
+    size_t carSegment = traffic.segmentOf(car);
+    float carOffset = traffic.offset[car];
+    float carReach = reach[traffic.type[car]];
+    float carSpeed = traffic.speed[car];
+
+    for (size_t k = 1; k <= count; k++) {
+        unsigned int other = traffic.ahead(car, k);
+        size_t distance = (traffic.segmentOf(other) + segments - carSegment) % segments;
+        if (distance >= limit)
+            return false;
+        if (distance == 0)
+            continue;
+
+        float otherOffset = traffic.offset[other];
+        float otherSpeed = traffic.speed[other];
+        if (carSpeed > otherSpeed && overlap(carOffset, carReach, otherOffset, reach[traffic.type[other]])) {
+            result = steer(carOffset, carSpeed, otherOffset, otherSpeed, static_cast<float>(distance), maxSpeed);
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(HAVE_SSE2)
+
+const char *Steering::kernelName() {
+    return "SSE2";
+}
+
+bool Steering::firstBlocking(const Traffic &traffic, unsigned int car, size_t count, size_t limit, size_t segments,
+                             float maxSpeed, float &result) const {
+    size_t rank = traffic.rankOf(car);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i carSegment = _mm_set1_epi32(segment[rank]);
+    const __m128i total = _mm_set1_epi32(static_cast<int>(segments));
+    const __m128i maxDistance = _mm_set1_epi32(static_cast<int>(limit));
+    const __m128 carMax = _mm_set1_ps(offset[rank] + carReach[rank]);
+    const __m128 carMin = _mm_set1_ps(offset[rank] - carReach[rank]);
+    const __m128 carSpeed = _mm_set1_ps(speed[rank]);
+
+    for (size_t done = 0; done < count; done += LANES) {
+        size_t i = rank + 1 + done;
+        int lanes = (1 << std::min<size_t>(count - done, LANES)) - 1;
+
+        // Distanza in segmenti (l'anello del tracciato si chiude)
+        __m128i distance = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&segment[i])), carSegment);
+        distance = _mm_add_epi32(distance, _mm_and_si128(_mm_cmplt_epi32(distance, zero), total));
+
+        // Le auto dalla prima oltre il limite in poi non contano
+        int beyond = (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(distance, maxDistance))) ^ 0xF) & lanes;
+        if (beyond != 0)
+            lanes &= (1 << LowestBit(beyond)) - 1;
+        lanes &= ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(distance, zero)));
+
+        __m128 otherOffset = _mm_loadu_ps(&offset[i]);
+        __m128 otherReach = _mm_loadu_ps(&carReach[i]);
+        __m128 blocked = _mm_and_ps(_mm_cmpge_ps(carMax, _mm_sub_ps(otherOffset, otherReach)),
+                                    _mm_cmple_ps(carMin, _mm_add_ps(otherOffset, otherReach)));
+        blocked = _mm_and_ps(blocked, _mm_cmpgt_ps(carSpeed, _mm_loadu_ps(&speed[i])));
+
+        int hits = _mm_movemask_ps(blocked) & lanes;
+        if (hits != 0) {
+            size_t j = i + LowestBit(hits);
+            int d = segment[j] - segment[rank];
+            if (d < 0)
+                d += static_cast<int>(segments);
+            result = steer(offset[rank], speed[rank], offset[j], speed[j], static_cast<float>(d), maxSpeed);
+            return true;
+        }
+        if (beyond != 0)
+            return false;
+    }
+    return false;
+}
+
+#else
+
+const char *Steering::kernelName() {
+    return "scalar";
+}
+
+bool Steering::firstBlocking(const Traffic &traffic, unsigned int car, size_t count, size_t limit, size_t segments,
+                             float maxSpeed, float &result) const {
+    return firstBlockingScalar(traffic, car, count, limit, segments, maxSpeed, result);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef __STEERING_HPP__
+#define __STEERING_HPP__
+
+#include <vector>
+#include <cstddef>
+
+#include "traffic.hpp"
+
+// Kernel dello sterzo del traffico. Le auto davanti a un'auto vicina sono le
+// successive nell'ordine per z, quindi a ogni passo lo stato che serve (offset,
+// semi larghezza, velocità, segmento) viene copiato in array contigui in quell'ordine,
+// ripetendo l'inizio dell'anello in coda. Gli ostacoli di un'auto sono così LANES
+// valori consecutivi, valutati insieme senza salti con SSE2 (uno alla volta sulle
+// altre architetture, come su OS4); ci si ferma al primo gruppo con un ostacolo.
+// Il risultato è identico bit per bit in tutte le versioni.
+class Steering
+{
+public:
+    static constexpr int LANES = 4;
+
+    // Versioni della ricerca dell'ostacolo (il benchmark le confronta)
+    enum Kernel { RING, SCALAR, VECTOR };
+    static constexpr float MARGIN = 1.2f;   // Le larghezze contano il 20% in più nella sovrapposizione
+
+    // Semi larghezza con margine di un oggetto largo width
+    static float reach(float width) { return width * (MARGIN / 2); }
+
+    // Sovrapposizione degli intervalli [offset - reach, offset + reach]
+    static bool overlap(float offset1, float reach1, float offset2, float reach2) {
+        return (offset1 + reach1 >= offset2 - reach2) & (offset1 - reach1 <= offset2 + reach2);
+    }
+
+    // Sterzo per evitare un ostacolo più lento a distance segmenti: verso il centro se
+    // l'ostacolo è su un lato, altrimenti dal lato in cui si trova già l'auto
+    static float steer(float carOffset, float carSpeed, float otherOffset, float otherSpeed, float distance,
+                       float maxSpeed) {
+        float dir = otherOffset > 0.5f ? -1.0f : (otherOffset < -0.5f ? 1.0f : (carOffset > otherOffset ? 1.0f : -1.0f));
+        return dir * (1.0f / distance) * (carSpeed - otherSpeed) / maxSpeed;
+    }
+
+    // Copia le auto vicine di traffic nell'ordine per z; reach è la semi larghezza di
+    // ogni tipo di auto
+    void build(const Traffic &traffic, const std::vector<float> &reach);
+
+    // Cerca il primo ostacolo che blocca l'auto car tra le count successive sull'anello,
+    // a meno di limit segmenti (quelle nello stesso segmento non contano): la ricerca
+    // si ferma alla prima auto oltre il limite. Se c'è ritorna true e in result lo sterzo.
+    bool firstBlocking(const Traffic &traffic, unsigned int car, size_t count, size_t limit, size_t segments,
+                       float maxSpeed, float &result) const;
+
+    // Stessa ricerca un'auto alla volta (fallback)
+    bool firstBlockingScalar(const Traffic &traffic, unsigned int car, size_t count, size_t limit, size_t segments,
+                             float maxSpeed, float &result) const;
+
+    // Stessa ricerca seguendo l'anello di traffic, senza copie (la versione precedente al
+    // kernel, riferimento del benchmark; non è la scansione per segmenti originale)
+    static bool firstBlockingRing(const Traffic &traffic, const std::vector<float> &reach, unsigned int car,
+                                  size_t count, size_t limit, size_t segments, float maxSpeed, float &result);
+
+    // Nome del kernel usato da firstBlocking
+    static const char *kernelName();
+
+private:
+    // Stato delle auto vicine nell'ordine per z (struct-of-arrays)
+    std::vector<float> offset;
+    std::vector<float> carReach;
+    std::vector<float> speed;
+    std::vector<int> segment;
+};
+
+#endif
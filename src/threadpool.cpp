@@ -0,0 +1,76 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0)
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < threads; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &worker: workers)
+        worker.join();
+}
+
+void ThreadPool::runJobs(const std::function<void(int)> &job, int count) {
+    for (int i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1))
+        job(i);
+}
+
+void ThreadPool::workerLoop() {
+    unsigned int seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping)
+            return;
+
+        seen = generation;
+        const std::function<void(int)> *job = currentJob;
+        int count = jobCount;
+
+        lock.unlock();
+        runJobs(*job, count);
+        lock.lock();
+
+        if (--pending == 0)
+            done.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &job) {
+    if (count <= 0)
+        return;
+
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++)
+            job(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        jobCount = count;
+        nextIndex = 0;
+        pending = static_cast<int>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+
+    runJobs(job, count);
+
+    // Ogni thread deve aver visto questo lavoro prima che job esca di scope
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return pending == 0; });
+}
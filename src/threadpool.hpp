@@ -0,0 +1,46 @@
+#ifndef __THREADPOOL_HPP__
+#define __THREADPOOL_HPP__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// Insieme di thread di lavoro sempre attivi. parallelFor distribuisce gli indici
+// di un lavoro tra i thread (compreso il chiamante) e ritorna quando sono finiti.
+class ThreadPool
+{
+public:
+    // threads: numero totale di thread compreso il chiamante, 0 = uno per core
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Esegue job(i) per ogni i in [0, count). Gli indici vengono presi uno alla volta
+    // da un contatore condiviso, quindi lavori di durata diversa si bilanciano da soli.
+    void parallelFor(int count, const std::function<void(int)> &job);
+
+private:
+    void workerLoop();
+    void runJobs(const std::function<void(int)> &job, int count);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(int)> *currentJob = nullptr;
+    int jobCount = 0;
+    std::atomic<int> nextIndex{0};
+    unsigned int generation = 0;    // Incrementato ad ogni parallelFor
+    int pending = 0;                // Thread che non hanno ancora finito il lavoro corrente
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include "timestep.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void FixedTimestep::setup(double _step, int _maxSteps) {
+    step = _step;
+    maxSteps = std::max(1, _maxSteps);
+    accumulator = 0.0;
+}
+
+int FixedTimestep::advance(double elapsed) {
+    accumulator += std::max(0.0, elapsed);
+
+    int steps = static_cast<int>(accumulator / step);
+    if (steps > maxSteps) {
+        steps = maxSteps;
+        accumulator = std::fmod(accumulator, step);
+    } else {
+        accumulator -= steps * step;
+    }
+
+    return steps;
+}
@@ -0,0 +1,29 @@
+#ifndef __TIMESTEP_HPP__
+#define __TIMESTEP_HPP__
+
+// Passo fisso della simulazione: il tempo reale trascorso si accumula e viene
+// consumato a passi di durata costante, così la fisica non dipende dalla frequenza
+// dei frame. Il resto dell'accumulatore dice quanto interpolare il disegno.
+class FixedTimestep
+{
+public:
+    void setup(double _step, int _maxSteps);
+
+    // Aggiunge il tempo reale trascorso (secondi) e ritorna quanti passi eseguire.
+    // Oltre maxSteps passi il tempo in eccesso viene scartato (il gioco rallenta
+    // invece di rincorrere frame sempre più lenti).
+    int advance(double elapsed);
+
+    // Frazione del passo successivo già trascorsa (0 - 1)
+    float alpha() const { return static_cast<float>(accumulator / step); }
+
+    double getStep() const { return step; }
+    int getMaxSteps() const { return maxSteps; }
+
+private:
+    double step = 1.0 / 60.0;
+    int maxSteps = 5;
+    double accumulator = 0.0;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "traffic.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+void Traffic::clear(size_t segments, float _segmentLength) {
+    segmentLength = _segmentLength;
+    trackLength = segments * segmentLength;
+    tick = 0;
+
+    head.assign(segments, NONE);
+    z.clear();
+    offset.clear();
+    speed.clear();
+    percent.clear();
+    type.clear();
+    nextZ.clear();
+    nextOffset.clear();
+    nextPercent.clear();
+    nextSegment.clear();
+    nextCar.clear();
+    prevCar.clear();
+    carSegment.clear();
+    order.clear();
+    rank.clear();
+    sortedZ.clear();
+    wrapped.clear();
+    baseZ.clear();
+    baseTick.clear();
+    wakes.clear();
+}
+
+void Traffic::setWindow(float _behind, float _ahead, float _margin, float _maxClosing, float _dt) {
+    behindDistance = _behind;
+    aheadDistance = _ahead;
+    margin = _margin;
+    maxClosing = _maxClosing;
+    dt = _dt;
+}
+
+unsigned int Traffic::add(float _z, float _offset, float _speed, unsigned char _type) {
+    unsigned int car = static_cast<unsigned int>(z.size());
+
+    z.push_back(_z);
+    offset.push_back(_offset);
+    speed.push_back(_speed);
+    percent.push_back(0.0f);
+    type.push_back(_type);
+    nextZ.push_back(_z);
+    nextOffset.push_back(_offset);
+    nextPercent.push_back(0.0f);
+    nextSegment.push_back(0);
+    nextCar.push_back(NONE);
+    prevCar.push_back(NONE);
+    carSegment.push_back(0);
+    rank.push_back(0);
+    sortedZ.push_back(_z);
+    baseZ.push_back(_z);
+    baseTick.push_back(tick);
+
+    // I buffer di lavoro vengono riservati qui per non allocare durante la simulazione
+    order.reserve(z.size());
+    wrapped.reserve(z.size());
+    wakes.reserve(z.size());
+
+    // Controllata al prossimo updateWindow
+    wakes.push_back({tick, car});
+    std::push_heap(wakes.begin(), wakes.end(), std::greater<Wake>());
+    return car;
+}
+
+float Traffic::windowGap(float carZ, float center, float extra) const {
+    float front = aheadDistance + extra;
+    float back = behindDistance + extra;
+    if (front + back >= trackLength)
+        return 0.0f;
+
+    float d = std::fmod(carZ - center, trackLength);
+    if (d < 0.0f)
+        d += trackLength;
+
+    if (d <= front || d >= trackLength - back)
+        return 0.0f;
+    return std::min(d - front, (trackLength - back) - d);
+}
+
+float Traffic::farZ(unsigned int car) const {
+    double travelled = static_cast<double>(speed[car]) * dt * (tick - baseTick[car]);
+    return static_cast<float>(std::fmod(baseZ[car] + travelled, static_cast<double>(trackLength)));
+}
+
+void Traffic::schedule(unsigned int car, float gap) {
+    // Prima di questo passo l'auto non può raggiungere la finestra (il margine copre
+    // i piccoli salti all'indietro del giocatore dopo una collisione)
+    float ticks = std::max(1.0f, (gap - margin) / (maxClosing * dt));
+    unsigned int delay = static_cast<unsigned int>(std::min(ticks, 1.0e9f));
+
+    wakes.push_back({tick + delay, car});
+    std::push_heap(wakes.begin(), wakes.end(), std::greater<Wake>());
+}
+
+void Traffic::updateWindow(float center) {
+    bool changed = false;
+
+    // Auto vicine uscite dalla finestra (oltre il margine): diventano lontane
+    size_t kept = 0;
+    for (size_t k = 0; k < order.size(); k++) {
+        unsigned int car = order[k];
+        float gap = windowGap(z[car], center, margin);
+        if (gap > 0.0f) {
+            unlink(car);
+            baseZ[car] = z[car];
+            baseTick[car] = tick;
+            nextOffset[car] = offset[car];
+            schedule(car, gap);
+            changed = true;
+        } else {
+            order[kept++] = car;
+        }
+    }
+    order.resize(kept);
+
+    // Auto lontane da ricontrollare: entrano se sono nella finestra
+    while (!wakes.empty() && wakes.front().tick <= tick) {
+        unsigned int car = wakes.front().car;
+        std::pop_heap(wakes.begin(), wakes.end(), std::greater<Wake>());
+        wakes.pop_back();
+
+        float carZ = farZ(car);
+        float gap = windowGap(carZ, center, 0.0f);
+        if (gap > 0.0f) {
+            baseZ[car] = carZ;
+            baseTick[car] = tick;
+            schedule(car, gap);
+            continue;
+        }
+
+        z[car] = carZ;
+        sortedZ[car] = carZ;
+        percent[car] = std::fmod(carZ, segmentLength) / segmentLength;
+        link(car, static_cast<size_t>(carZ / segmentLength) % head.size());
+
+        auto it = std::upper_bound(order.begin(), order.end(), carZ,
+                                   [this](float value, unsigned int other) { return value < z[other]; });
+        order.insert(it, car);
+        changed = true;
+    }
+
+    if (changed) {
+        for (size_t k = 0; k < order.size(); k++)
+            rank[order[k]] = static_cast<unsigned int>(k);
+    }
+}
+
+void Traffic::commit() {
+    z.swap(nextZ);
+    offset.swap(nextOffset);
+    percent.swap(nextPercent);
+
+    for (unsigned int car: order)
+        move(car, nextSegment[car]);
+
+    sort();
+    tick++;
+}
+
+void Traffic::sort() {
+    size_t count = order.size();
+
+    // Le auto che hanno passato il traguardo (z diminuito) passano in testa
+    size_t kept = 0;
+    wrapped.clear();
+    for (size_t k = 0; k < count; k++) {
+        unsigned int car = order[k];
+        if (z[car] < sortedZ[car])
+            wrapped.push_back(car);
+        else
+            order[kept++] = car;
+    }
+    if (!wrapped.empty()) {
+        std::copy_backward(order.begin(), order.begin() + kept, order.end());
+        std::copy(wrapped.begin(), wrapped.end(), order.begin());
+    }
+
+    // Insertion sort: lineare sui dati quasi ordinati
+    for (size_t k = 1; k < count; k++) {
+        unsigned int car = order[k];
+        float value = z[car];
+        size_t j = k;
+        while (j > 0 && z[order[j - 1]] > value) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = car;
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        unsigned int car = order[k];
+        rank[car] = static_cast<unsigned int>(k);
+        sortedZ[car] = z[car];
+    }
+}
+
+void Traffic::move(unsigned int car, size_t segment) {
+    if (carSegment[car] == segment)
+        return;
+
+    unlink(car);
+    link(car, segment);
+}
+
+void Traffic::link(unsigned int car, size_t segment) {
+    unsigned int first = head[segment];
+
+    prevCar[car] = NONE;
+    nextCar[car] = first;
+    if (first != NONE)
+        prevCar[first] = car;
+    head[segment] = car;
+    carSegment[car] = static_cast<unsigned int>(segment);
+}
+
+void Traffic::unlink(unsigned int car) {
+    unsigned int prev = prevCar[car];
+    unsigned int next = nextCar[car];
+
+    if (prev != NONE)
+        nextCar[prev] = next;
+    else
+        head[carSegment[car]] = next;
+    if (next != NONE)
+        prevCar[next] = prev;
+}
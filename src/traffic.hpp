@@ -0,0 +1,129 @@
+#ifndef __TRAFFIC_HPP__
+#define __TRAFFIC_HPP__
+
+#include <vector>
+#include <cstddef>
+
+#include "common.hpp"
+
+// Archivio delle auto del traffico (struct-of-arrays).
+// Ogni auto esiste una sola volta; i segmenti la referenziano tramite una lista
+// doppiamente concatenata di indici, così spostare un'auto da un segmento
+// all'altro costa O(1) e non alloca memoria.
+// Solo le auto vicine al giocatore (dentro la finestra) sono simulate, collegate ai
+// segmenti e ordinate per z su un anello (il tracciato si ripete): le vicine di
+// un'auto sono le posizioni adiacenti nell'ordine. Le auto lontane avanzano in
+// forma chiusa (z + speed * tempo) e vengono ricontrollate solo quando potrebbero
+// essere entrate nella finestra, in ordine di risveglio su una min-heap.
+class Traffic
+{
+public:
+    static constexpr unsigned int NONE = 0xFFFFFFFFu;   // Fine della lista
+    static constexpr int BLOCK = 256;                   // Auto per lavoro quando il passo è parallelo
+
+    // Svuota il traffico per una strada di segments segmenti
+    void clear(size_t segments, float _segmentLength);
+
+    // Finestra delle auto simulate: da behind prima ad ahead dopo il giocatore, le auto
+    // escono solo oltre margin. maxClosing è la velocità massima con cui un'auto lontana
+    // e il giocatore possono avvicinarsi, dt la durata di un passo.
+    void setWindow(float _behind, float _ahead, float _margin, float _maxClosing, float _dt);
+
+    // Aggiunge un'auto (lontana fino al prossimo updateWindow) e ne ritorna l'indice
+    unsigned int add(float _z, float _offset, float _speed, unsigned char _type);
+
+    // Aggiorna gli insiemi delle auto vicine e lontane per il giocatore in center
+    void updateWindow(float center);
+
+    size_t size() const { return z.size(); }
+
+    // Auto vicine, ordinate per z
+    size_t nearCount() const { return order.size(); }
+    unsigned int nearCar(size_t k) const { return order[k]; }
+    size_t rankOf(unsigned int car) const { return rank[car]; }  // Posizione dell'auto vicina nell'ordine
+
+    // Auto del segmento: for (i = first(s); i != NONE; i = next(i))
+    unsigned int first(size_t segment) const { return head[segment]; }
+    unsigned int next(unsigned int car) const { return nextCar[car]; }
+    size_t segmentOf(unsigned int car) const { return carSegment[car]; }
+
+    const Sprite &sprite(unsigned int car) const { return CARS[type[car]]; }
+
+    // Stato del passo precedente di un'auto vicina, per interpolare il disegno: dopo
+    // commit i buffer next* contengono lo stato prima del passo
+    float previousZ(unsigned int car) const { return nextZ[car]; }
+    float previousOffset(unsigned int car) const { return nextOffset[car]; }
+
+    // Rende attuale lo stato scritto nei buffer next* dalle auto vicine: scambia i
+    // buffer, sposta le auto tra i segmenti e riordina
+    void commit();
+
+    // Auto vicina successiva lungo l'anello ordinato per z (la prima dopo l'ultima)
+    unsigned int ahead(unsigned int car, size_t steps) const {
+        return order[(rank[car] + steps) % order.size()];
+    }
+
+    std::vector<float> z;               // Posizione lungo il tracciato (solo auto vicine)
+    std::vector<float> offset;          // Offset sulla strada (-1 a 1)
+    std::vector<float> speed;           // Velocità
+    std::vector<float> percent;         // Posizione all'interno del segmento (0 - 1)
+    std::vector<unsigned char> type;    // Indice dello sprite in CARS
+
+    // Stato del passo successivo (doppio buffer). Il passo del traffico legge solo lo
+    // stato attuale e scrive qui, quindi ogni auto è indipendente dalle altre: il
+    // risultato non dipende dall'ordine di aggiornamento né dal numero di thread.
+    std::vector<float> nextZ;
+    std::vector<float> nextOffset;
+    std::vector<float> nextPercent;
+    std::vector<unsigned int> nextSegment;
+
+private:
+    struct Wake {
+        unsigned int tick;              // Passo in cui ricontrollare l'auto
+        unsigned int car;
+
+        bool operator>(const Wake &other) const {
+            return tick != other.tick ? tick > other.tick : car > other.car;
+        }
+    };
+
+    // Riordina le auto vicine per z dopo che si sono mosse. L'ordine cambia poco tra un
+    // passo e l'altro (sorpassi e auto oltre il traguardo), quindi il costo è lineare.
+    void sort();
+
+    // Distanza di z dalla finestra allargata di extra (0 = dentro)
+    float windowGap(float carZ, float center, float extra) const;
+    // Posizione in forma chiusa di un'auto lontana al passo attuale
+    float farZ(unsigned int car) const;
+    // Mette un'auto lontana in coda per il controllo dopo aver percorso gap
+    void schedule(unsigned int car, float gap);
+
+    void move(unsigned int car, size_t segment);
+    void link(unsigned int car, size_t segment);
+    void unlink(unsigned int car);
+
+    float segmentLength = 200.0f;
+    float trackLength = 0.0f;
+    float behindDistance = 0.0f;
+    float aheadDistance = 0.0f;
+    float margin = 0.0f;
+    float maxClosing = 1.0f;
+    float dt = 1.0f / 60.0f;
+    unsigned int tick = 0;                  // Passi eseguiti
+
+    std::vector<unsigned int> head;         // Prima auto di ogni segmento
+    std::vector<unsigned int> nextCar;
+    std::vector<unsigned int> prevCar;
+    std::vector<unsigned int> carSegment;   // Segmento in cui si trova ogni auto vicina
+
+    std::vector<unsigned int> order;        // Auto vicine ordinate per z
+    std::vector<unsigned int> rank;         // Posizione di ogni auto vicina in order
+    std::vector<float> sortedZ;             // z di ogni auto vicina all'ultimo sort
+    std::vector<unsigned int> wrapped;      // Auto oltre il traguardo (buffer di lavoro di sort)
+
+    std::vector<float> baseZ;               // Auto lontane: z al passo baseTick
+    std::vector<unsigned int> baseTick;
+    std::vector<Wake> wakes;                // Min-heap dei risvegli delle auto lontane
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <vector>
 #include <string>
+#include <cstdint>
 
 #include "common.hpp"
 
@@ -21,10 +22,6 @@ public:
         return static_cast<long long>(std::time(nullptr)) * 1000;
     }
 
-    static float randomFloat() {
-        return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-    }
-
     // Converte un valore in intero con un valore di default
     static int toInt(const std::string &obj, int def)
     {
@@ -57,19 +54,6 @@ public:
         return std::max(min, std::min(value, max));
     }
 
-    // Restituisce un intero casuale tra min e max
-    static int randomInt(int min, int max)
-    {
-        return min + rand() % ((max - min) + 1);
-    }
-
-    // Restituisce una scelta casuale da un array
-    template <typename T>
-    static T randomChoice(const std::vector<T> &options)
-    {
-        return options[randomInt(0, static_cast<int>(options.size()) - 1)];
-    }
-
     // Calcola la percentuale rimanente di n rispetto a total
     static float percentRemaining(float n, float total)
     {
@@ -88,6 +72,17 @@ public:
         return a + (b - a) * percent;
     }
 
+    // Interpolazione lineare di un valore che si riavvolge a max (prende la via più breve)
+    static float interpolateWrapped(float a, float b, float percent, float max)
+    {
+        float delta = b - a;
+        if (delta > max / 2)
+            delta -= max;
+        else if (delta < -max / 2)
+            delta += max;
+        return increase(a, delta * percent, max);
+    }
+
     // Easing in
     static float easeIn(float a, float b, float percent)
     {
@@ -123,16 +118,13 @@ public:
         return result;
     }
 
-    // Proiezione prospettica
-    static void project(Point3D &p, float cameraX, float cameraY, float cameraZ, float _cameraDepth, float _width, float _height, float _roadWidth)
+    // Hash FNV-1a a 64 bit di un blocco di memoria (concatenabile tramite h)
+    static uint64_t hash(const void *data, size_t size, uint64_t h = 14695981039346656037ull)
     {
-        p.camera.x = p.world.x - cameraX;
-        p.camera.y = p.world.y - cameraY;
-        p.camera.z = p.world.z - cameraZ;
-        p.screen.scale = _cameraDepth / p.camera.z;
-        p.screen.x = round((_width / 2) + (p.screen.scale * p.camera.x * _width / 2));
-        p.screen.y = round((_height / 2) - (p.screen.scale * p.camera.y * _height / 2));
-        p.screen.w = round(p.screen.scale * _roadWidth * _width / 2);
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+            h = (h ^ bytes[i]) * 1099511628211ull;
+        return h;
     }
 
     static bool overlap(Rectangle player, Rectangle car) {